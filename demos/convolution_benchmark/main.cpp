@@ -0,0 +1,162 @@
+#include "libdsp/storage/buffer.h"
+#include "libdsp/signal_processing/signal_processing.h"
+#include "libdsp/signal_processing/convolution_planner.h"
+#include "libdsp/signal_processing/direct_convolution.h"
+#include "libdsp/signal_processing/fast_convolution.h"
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    constexpr int INPUT_SIGNAL_LENGTH = 16384;
+
+    /**
+     * Runs `fn` repeatedly for at least ~100ms and returns the mean time per call in microseconds.
+     */
+    double timeMicroseconds(const std::function<void()>& fn)
+    {
+        using clock = std::chrono::steady_clock;
+        constexpr auto minimumDuration = std::chrono::milliseconds(100);
+
+        fn(); // warm-up
+        int iterations = 0;
+        const auto start = clock::now();
+        auto elapsed = clock::duration::zero();
+        do
+        {
+            fn();
+            ++iterations;
+            elapsed = clock::now() - start;
+        } while (elapsed < minimumDuration);
+
+        return std::chrono::duration<double, std::micro>(elapsed).count() / iterations;
+    }
+
+    template<int N>
+    void fillRandom(dsp::StaticBuffer<double, N>& buffer, std::mt19937& gen)
+    {
+        std::uniform_real_distribution<double> d{-1.0, 1.0};
+        for (int i = 0; i < N; ++i)
+        {
+            buffer._data[i] = d(gen);
+        }
+    }
+
+    struct BenchmarkResult
+    {
+        int impulseResponseLength;
+        double directUs;
+        double simdUs;
+        double overlapAddUs;
+        double overlapSaveUs;
+    };
+
+    template<int ImpulseResponseLength>
+    BenchmarkResult runCase()
+    {
+        std::mt19937 gen{1234};
+        auto x = std::make_unique<dsp::StaticBuffer<double, INPUT_SIGNAL_LENGTH>>();
+        auto h = std::make_unique<dsp::StaticBuffer<double, ImpulseResponseLength>>();
+        fillRandom(*x, gen);
+        fillRandom(*h, gen);
+
+        double sink = 0.0;
+        BenchmarkResult result{ImpulseResponseLength};
+        result.directUs = timeMicroseconds([&]() {
+            sink += dsp::signals::convolve1D<double, INPUT_SIGNAL_LENGTH, ImpulseResponseLength>(*x, *h)._data[0];
+        });
+        result.simdUs = timeMicroseconds([&]() {
+            sink += dsp::signals::convolve1DSimd(*x, *h)._data[0];
+        });
+        result.overlapAddUs = timeMicroseconds([&]() {
+            sink += dsp::signals::fftConvolve1D(*x, *h, dsp::signals::BlockMode::OverlapAdd)._data[0];
+        });
+        result.overlapSaveUs = timeMicroseconds([&]() {
+            sink += dsp::signals::fftConvolve1D(*x, *h, dsp::signals::BlockMode::OverlapSave)._data[0];
+        });
+
+        // Keep the optimizer from discarding the convolutions
+        if (sink == 42.0)
+        {
+            std::cout << "";
+        }
+        return result;
+    }
+}
+
+// Times direct-form convolve1D (plain and vectorized) against FFT overlap-add/overlap-save for a
+// fixed-length input and a range of impulse response lengths, and reports where the FFT path starts winning.
+//
+// `convolution_benchmark --calibrate <path>` instead measures this machine's crossover points for
+// dsp::signals::convolve() and saves them to <path>; point DSP_CONVOLUTION_CALIBRATION at that file
+// to have later runs load it on startup.
+int main(int argc, char* argv[])
+{
+    if (argc == 3 && std::string_view(argv[1]) == "--calibrate")
+    {
+        auto& planner = dsp::signals::ConvolutionPlanner::instance();
+        std::cout << "Calibrating convolution strategies...\n";
+        planner.calibrate();
+        if (!planner.saveCalibration(argv[2]))
+        {
+            std::cerr << std::format("Could not write calibration to {}\n", argv[2]);
+            return 1;
+        }
+        std::cout << std::format("Saved calibration to {}\n", argv[2]);
+        return 0;
+    }
+
+    std::vector<BenchmarkResult> results;
+    [&results]<int... ImpulseResponseLengths>(std::integer_sequence<int, ImpulseResponseLengths...>)
+    {
+        (results.push_back(runCase<ImpulseResponseLengths>()), ...);
+    }(std::integer_sequence<int, 4, 8, 16, 32, 64, 128, 256, 512, 1024, 2048, 4096>{});
+
+    std::cout << std::format("Input signal length N = {}\n\n", INPUT_SIGNAL_LENGTH);
+    std::cout << std::format("{:>8} {:>14} {:>14} {:>14} {:>14} {:>10}\n", "M", "direct (us)", "SIMD (us)", "OLA (us)", "OLS (us)", "speedup");
+
+    int crossover = -1;
+    int simdCrossover = -1;
+    for (const auto& result : results)
+    {
+        const double fastest = std::min(result.overlapAddUs, result.overlapSaveUs);
+        std::cout << std::format("{:>8} {:>14.1f} {:>14.1f} {:>14.1f} {:>14.1f} {:>9.2f}x\n",
+                                 result.impulseResponseLength,
+                                 result.directUs,
+                                 result.simdUs,
+                                 result.overlapAddUs,
+                                 result.overlapSaveUs,
+                                 result.directUs / fastest);
+        if (crossover < 0 && fastest < result.directUs)
+        {
+            crossover = result.impulseResponseLength;
+        }
+        if (simdCrossover < 0 && fastest < result.simdUs)
+        {
+            simdCrossover = result.impulseResponseLength;
+        }
+    }
+
+    if (crossover > 0)
+    {
+        std::cout << std::format("\nFFT convolution overtakes direct form at M = {} taps.\n", crossover);
+    }
+    else
+    {
+        std::cout << "\nDirect form was faster for every impulse response length tested.\n";
+    }
+    if (simdCrossover > 0)
+    {
+        std::cout << std::format("FFT convolution overtakes SIMD direct form at M = {} taps.\n", simdCrossover);
+    }
+    return 0;
+}
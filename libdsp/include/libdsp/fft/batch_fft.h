@@ -0,0 +1,324 @@
+#ifndef SIGNAL_PROCESSING_BOOK_BATCH_FFT_H
+#define SIGNAL_PROCESSING_BOOK_BATCH_FFT_H
+
+#include "libdsp/fft/plan_cache.h"
+#include "libdsp/storage/buffer.h"
+
+#include <algorithm>
+#include <complex>
+#include <concepts>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace dsp::fft
+{
+    /**
+     * Where each transform of a batch lives in memory. Sample i of transform b is at
+     * data[b * distance + i * stride].
+     *  - Frame-major (e.g. spectrogram frames back to back): stride = 1, distance = N
+     *  - Interleaved multichannel (one transform per channel): stride = channels, distance = 1
+     */
+    struct BatchLayout
+    {
+        int count;
+        int stride;
+        int distance;
+    };
+
+    /**
+     * Runs many same-sized FFTs in lockstep, one transform per SIMD lane.
+     *
+     * Transforms are gathered LANES at a time into a split real/imaginary scratch block where
+     * lane l of every sample belongs to transform l. Every butterfly then applies the same twiddle
+     * to all lanes, so the inner loops are plain fixed-length loops over lanes that the compiler
+     * turns into vector instructions. This keeps the SIMD units busy for small transforms
+     * (64 - 1024 points) that are too short to vectorize well on their own.
+     *
+     * Uses the stage layout, digit reversal and twiddles of the matching cached Plan.
+     * @tparam T The floating point precision of the transform (float or double).
+     */
+    template<std::floating_point T>
+    class BatchPlan
+    {
+    public:
+        /**
+         * Transforms per group: enough to fill a 256-bit vector register.
+         */
+        static constexpr int LANES = 32 / sizeof(T);
+
+        BatchPlan(int size, Direction direction)
+            : _plan(PlanCache::instance().complexPlan<T>(size, direction))
+        {
+            // Replay the plan's swaps to find which input sample lands at each position
+            _source.resize(size);
+            for (int i = 0; i < size; ++i)
+            {
+                _source[i] = i;
+            }
+            for (const auto& [a, b] : _plan->_swaps)
+            {
+                std::swap(_source[a], _source[b]);
+            }
+        }
+
+        [[nodiscard]] int size() const { return _plan->size(); }
+        [[nodiscard]] Direction direction() const { return _plan->direction(); }
+
+        /**
+         * Transforms every transform described by `layout` in place. Every sample the layout
+         * addresses must lie inside `data`.
+         */
+        void execute(std::span<std::complex<T>> data, const BatchLayout& layout) const
+        {
+            const int n = size();
+            if (layout.count < 0 || layout.stride < 0 || layout.distance < 0)
+            {
+                throw std::invalid_argument("dsp::fft::BatchPlan: layout count, stride and distance must not be negative");
+            }
+            if (layout.count == 0)
+            {
+                return;
+            }
+            const long long last = static_cast<long long>(layout.count - 1) * layout.distance +
+                                   static_cast<long long>(n - 1) * layout.stride;
+            if (last >= static_cast<long long>(data.size()))
+            {
+                throw std::invalid_argument("dsp::fft::BatchPlan: layout reaches past the end of the data");
+            }
+
+            std::vector<T> re(static_cast<size_t>(n) * LANES);
+            std::vector<T> im(static_cast<size_t>(n) * LANES);
+            const T scale = direction() == Direction::Inverse ? T(1) / T(n) : T(1);
+
+            for (int first = 0; first < layout.count; first += LANES)
+            {
+                const int lanes = std::min(LANES, layout.count - first);
+
+                // Gather with the digit reversal folded in; unused lanes are zero-filled
+                for (int i = 0; i < n; ++i)
+                {
+                    const size_t offset = static_cast<size_t>(_source[i]) * layout.stride;
+                    for (int l = 0; l < LANES; ++l)
+                    {
+                        const std::complex<T> value = l < lanes ? data[static_cast<size_t>(first + l) * layout.distance + offset]
+                                                                : std::complex<T>{};
+                        re[i * LANES + l] = value.real();
+                        im[i * LANES + l] = value.imag();
+                    }
+                }
+
+                for (const auto& stage : _plan->_stages)
+                {
+                    switch (stage.radix)
+                    {
+                        case 2: runStage<2>(re.data(), im.data(), stage); break;
+                        case 3: runStage<3>(re.data(), im.data(), stage); break;
+                        case 4: runStage<4>(re.data(), im.data(), stage); break;
+                        case 5: runStage<5>(re.data(), im.data(), stage); break;
+                        default: break;
+                    }
+                }
+
+                for (int i = 0; i < n; ++i)
+                {
+                    const size_t offset = static_cast<size_t>(i) * layout.stride;
+                    for (int l = 0; l < lanes; ++l)
+                    {
+                        data[static_cast<size_t>(first + l) * layout.distance + offset] = {re[i * LANES + l] * scale,
+                                                                                           im[i * LANES + l] * scale};
+                    }
+                }
+            }
+        }
+
+    private:
+        using Stage = typename Plan<T>::Stage;
+
+        template<int Radix>
+        void runStage(T* re, T* im, const Stage& stage) const
+        {
+            const int n = size();
+            const int m = stage.subLength;
+            const int length = m * Radix;
+            const std::complex<T>* twiddles = _plan->_twiddles.data() + stage.twiddleOffset;
+
+            alignas(32) T ar[Radix][LANES];
+            alignas(32) T ai[Radix][LANES];
+            for (int block = 0; block < n; block += length)
+            {
+                for (int j = 0; j < m; ++j)
+                {
+                    const int base = block + j;
+                    for (int l = 0; l < LANES; ++l)
+                    {
+                        ar[0][l] = re[base * LANES + l];
+                        ai[0][l] = im[base * LANES + l];
+                    }
+                    for (int q = 1; q < Radix; ++q)
+                    {
+                        const T* xr = re + (base + q * m) * LANES;
+                        const T* xi = im + (base + q * m) * LANES;
+                        const std::complex<T> w = m == 1 ? std::complex<T>{T(1), T(0)}
+                                                         : twiddles[j * (Radix - 1) + q - 1];
+                        const T wr = w.real();
+                        const T wi = w.imag();
+                        for (int l = 0; l < LANES; ++l)
+                        {
+                            ar[q][l] = xr[l] * wr - xi[l] * wi;
+                            ai[q][l] = xr[l] * wi + xi[l] * wr;
+                        }
+                    }
+
+                    butterfly<Radix>(ar, ai);
+
+                    for (int k = 0; k < Radix; ++k)
+                    {
+                        T* yr = re + (base + k * m) * LANES;
+                        T* yi = im + (base + k * m) * LANES;
+                        for (int l = 0; l < LANES; ++l)
+                        {
+                            yr[l] = ar[k][l];
+                            yi[l] = ai[k][l];
+                        }
+                    }
+                }
+            }
+        }
+
+        /**
+         * Lane-wise versions of Plan's butterflies; see Plan::butterfly for the derivations.
+         */
+        template<int Radix>
+        void butterfly(T (&ar)[Radix][LANES], T (&ai)[Radix][LANES]) const
+        {
+            if constexpr (Radix == 2)
+            {
+                for (int l = 0; l < LANES; ++l)
+                {
+                    const T tr = ar[1][l];
+                    const T ti = ai[1][l];
+                    ar[1][l] = ar[0][l] - tr;
+                    ai[1][l] = ai[0][l] - ti;
+                    ar[0][l] = ar[0][l] + tr;
+                    ai[0][l] = ai[0][l] + ti;
+                }
+            }
+            else if constexpr (Radix == 4)
+            {
+                // rotate() multiplies by -i (forward) or +i (inverse)
+                const T rotation = direction() == Direction::Forward ? T(1) : T(-1);
+                for (int l = 0; l < LANES; ++l)
+                {
+                    const T t0r = ar[0][l] + ar[2][l];
+                    const T t0i = ai[0][l] + ai[2][l];
+                    const T t1r = ar[0][l] - ar[2][l];
+                    const T t1i = ai[0][l] - ai[2][l];
+                    const T t2r = ar[1][l] + ar[3][l];
+                    const T t2i = ai[1][l] + ai[3][l];
+                    const T dr = ar[1][l] - ar[3][l];
+                    const T di = ai[1][l] - ai[3][l];
+                    const T t3r = rotation * di;
+                    const T t3i = -rotation * dr;
+                    ar[0][l] = t0r + t2r;
+                    ai[0][l] = t0i + t2i;
+                    ar[1][l] = t1r + t3r;
+                    ai[1][l] = t1i + t3i;
+                    ar[2][l] = t0r - t2r;
+                    ai[2][l] = t0i - t2i;
+                    ar[3][l] = t1r - t3r;
+                    ai[3][l] = t1i - t3i;
+                }
+            }
+            else if constexpr (Radix == 3)
+            {
+                const T c = _plan->_radix3.real();
+                const T s = _plan->_radix3.imag();
+                for (int l = 0; l < LANES; ++l)
+                {
+                    const T sr = ar[1][l] + ar[2][l];
+                    const T si = ai[1][l] + ai[2][l];
+                    const T dr = ar[1][l] - ar[2][l];
+                    const T di = ai[1][l] - ai[2][l];
+                    const T mr = ar[0][l] + c * sr;
+                    const T mi = ai[0][l] + c * si;
+                    const T rr = -s * di;
+                    const T ri = s * dr;
+                    ar[0][l] = ar[0][l] + sr;
+                    ai[0][l] = ai[0][l] + si;
+                    ar[1][l] = mr + rr;
+                    ai[1][l] = mi + ri;
+                    ar[2][l] = mr - rr;
+                    ai[2][l] = mi - ri;
+                }
+            }
+            else if constexpr (Radix == 5)
+            {
+                const T c1 = _plan->_radix5[0].real();
+                const T s1 = _plan->_radix5[0].imag();
+                const T c2 = _plan->_radix5[1].real();
+                const T s2 = _plan->_radix5[1].imag();
+                for (int l = 0; l < LANES; ++l)
+                {
+                    const T b1r = ar[1][l] + ar[4][l];
+                    const T b1i = ai[1][l] + ai[4][l];
+                    const T b2r = ar[2][l] + ar[3][l];
+                    const T b2i = ai[2][l] + ai[3][l];
+                    const T d1r = ar[1][l] - ar[4][l];
+                    const T d1i = ai[1][l] - ai[4][l];
+                    const T d2r = ar[2][l] - ar[3][l];
+                    const T d2i = ai[2][l] - ai[3][l];
+                    const T m1r = ar[0][l] + c1 * b1r + c2 * b2r;
+                    const T m1i = ai[0][l] + c1 * b1i + c2 * b2i;
+                    const T m2r = ar[0][l] + c2 * b1r + c1 * b2r;
+                    const T m2i = ai[0][l] + c2 * b1i + c1 * b2i;
+                    // i * (s1 * d1 + s2 * d2) and i * (s2 * d1 - s1 * d2)
+                    const T r1r = -(s1 * d1i + s2 * d2i);
+                    const T r1i = s1 * d1r + s2 * d2r;
+                    const T r2r = -(s2 * d1i - s1 * d2i);
+                    const T r2i = s2 * d1r - s1 * d2r;
+                    ar[0][l] = ar[0][l] + b1r + b2r;
+                    ai[0][l] = ai[0][l] + b1i + b2i;
+                    ar[1][l] = m1r + r1r;
+                    ai[1][l] = m1i + r1i;
+                    ar[2][l] = m2r + r2r;
+                    ai[2][l] = m2i + r2i;
+                    ar[3][l] = m2r - r2r;
+                    ai[3][l] = m2i - r2i;
+                    ar[4][l] = m1r - r1r;
+                    ai[4][l] = m1i - r1i;
+                }
+            }
+        }
+
+        std::shared_ptr<const Plan<T>> _plan;
+        std::vector<int> _source;
+    };
+
+    /**
+     * Forward FFTs of a frame-major libdsp buffer holding Total / N back to back transforms
+     * of N points each, in place.
+     * @tparam N The length of each transform. Must only have prime factors 2, 3 and 5.
+     */
+    template<int N, std::floating_point T, int Total>
+    void forwardBatch(StaticBuffer<std::complex<T>, Total>& frames)
+    {
+        static_assert(Total % N == 0, "Buffer must hold a whole number of transforms");
+        BatchPlan<T>(N, Direction::Forward).execute(frames._data, {Total / N, 1, N});
+    }
+
+    /**
+     * Inverse FFTs (scaled by 1/N) of a frame-major libdsp buffer holding Total / N back to back
+     * transforms of N points each, in place.
+     * @tparam N The length of each transform. Must only have prime factors 2, 3 and 5.
+     */
+    template<int N, std::floating_point T, int Total>
+    void inverseBatch(StaticBuffer<std::complex<T>, Total>& frames)
+    {
+        static_assert(Total % N == 0, "Buffer must hold a whole number of transforms");
+        BatchPlan<T>(N, Direction::Inverse).execute(frames._data, {Total / N, 1, N});
+    }
+}
+
+#endif //SIGNAL_PROCESSING_BOOK_BATCH_FFT_H
@@ -0,0 +1,64 @@
+#ifndef SIGNAL_PROCESSING_BOOK_BUFFER_TRANSFORMS_H
+#define SIGNAL_PROCESSING_BOOK_BUFFER_TRANSFORMS_H
+
+#include "libdsp/fft/plan_cache.h"
+#include "libdsp/storage/buffer.h"
+
+#include <complex>
+#include <concepts>
+#include <span>
+
+namespace dsp::fft
+{
+    /**
+     * Forward FFT of a libdsp buffer, in place. Uses the process-wide PlanCache.
+     * @tparam T The floating point precision of the transform (float or double).
+     * @tparam N The transform size. Must only have prime factors 2, 3 and 5.
+     */
+    template<std::floating_point T, int N>
+    void forward(StaticBuffer<std::complex<T>, N>& buffer)
+    {
+        PlanCache::instance().complexPlan<T>(N, Direction::Forward)->execute(buffer._data);
+    }
+
+    /**
+     * Inverse FFT of a libdsp buffer, in place (scaled by 1/N). Uses the process-wide PlanCache.
+     * @tparam T The floating point precision of the transform (float or double).
+     * @tparam N The transform size. Must only have prime factors 2, 3 and 5.
+     */
+    template<std::floating_point T, int N>
+    void inverse(StaticBuffer<std::complex<T>, N>& buffer)
+    {
+        PlanCache::instance().complexPlan<T>(N, Direction::Inverse)->execute(buffer._data);
+    }
+
+    /**
+     * Forward FFT of a real libdsp buffer, returning the N/2 + 1 bin half spectrum.
+     * Uses the process-wide PlanCache.
+     * @tparam T The floating point precision of the transform (float or double).
+     * @tparam N The transform size. Must be even, and N/2 must only have prime factors 2, 3 and 5.
+     */
+    template<std::floating_point T, int N>
+    StaticBuffer<std::complex<T>, N / 2 + 1> forwardReal(const StaticBuffer<T, N>& buffer)
+    {
+        StaticBuffer<std::complex<T>, N / 2 + 1> spectrum;
+        PlanCache::instance().realPlan<T>(N, Direction::Forward)->execute(std::span<const T>(buffer._data), spectrum._data);
+        return spectrum;
+    }
+
+    /**
+     * Inverse FFT of an N/2 + 1 bin half spectrum back into N real samples (scaled by 1/N).
+     * Uses the process-wide PlanCache.
+     * @tparam N The transform size. Must be given explicitly, since N and N + 1 share a spectrum size.
+     * @tparam T The floating point precision of the transform (float or double).
+     */
+    template<int N, std::floating_point T>
+    StaticBuffer<T, N> inverseReal(const StaticBuffer<std::complex<T>, N / 2 + 1>& spectrum)
+    {
+        StaticBuffer<T, N> buffer;
+        PlanCache::instance().realPlan<T>(N, Direction::Inverse)->execute(std::span<const std::complex<T>>(spectrum._data), buffer._data);
+        return buffer;
+    }
+}
+
+#endif //SIGNAL_PROCESSING_BOOK_BUFFER_TRANSFORMS_H
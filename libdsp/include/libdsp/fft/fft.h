@@ -0,0 +1,419 @@
+#ifndef SIGNAL_PROCESSING_BOOK_FFT_H
+#define SIGNAL_PROCESSING_BOOK_FFT_H
+
+#include <complex>
+#include <concepts>
+#include <numbers>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace dsp::fft
+{
+    enum class Direction
+    {
+        Forward,
+        Inverse
+    };
+
+    /**
+     * @return The smallest power of two that is >= n.
+     */
+    constexpr int nextPowerOfTwo(int n)
+    {
+        int p = 1;
+        while (p < n)
+        {
+            p <<= 1;
+        }
+        return p;
+    }
+
+    constexpr bool isPowerOfTwo(int n)
+    {
+        return n > 0 && (n & (n - 1)) == 0;
+    }
+
+    /**
+     * @return True if n only has prime factors 2, 3 and 5, i.e. can be transformed by Plan.
+     */
+    constexpr bool isSupportedSize(int n)
+    {
+        if (n < 1)
+        {
+            return false;
+        }
+        for (int p : {2, 3, 5})
+        {
+            while (n % p == 0)
+            {
+                n /= p;
+            }
+        }
+        return n == 1;
+    }
+
+    /**
+     * @return The smallest size >= n that Plan supports (only has prime factors 2, 3 and 5).
+     */
+    constexpr int nextSupportedSize(int n)
+    {
+        while (!isSupportedSize(n))
+        {
+            ++n;
+        }
+        return n;
+    }
+
+    /**
+     * Splits n into the butterfly radices used by Plan, in the order the stages run.
+     * Powers of two are covered with radix-4 stages plus at most one radix-2 stage, followed by
+     * the radix-3 and radix-5 stages.
+     * @return The radices, or an empty list if n has a prime factor other than 2, 3 or 5.
+     */
+    inline std::vector<int> factorize(int n)
+    {
+        if (!isSupportedSize(n))
+        {
+            return {};
+        }
+
+        std::vector<int> radices;
+        int twos = 0;
+        while (n % 2 == 0)
+        {
+            n /= 2;
+            ++twos;
+        }
+        if (twos % 2 == 1)
+        {
+            radices.push_back(2);
+        }
+        for (int i = 0; i < twos / 2; ++i)
+        {
+            radices.push_back(4);
+        }
+        for (int p : {3, 5})
+        {
+            while (n % p == 0)
+            {
+                n /= p;
+                radices.push_back(p);
+            }
+        }
+        return radices;
+    }
+
+    namespace detail
+    {
+        // Complex products written out by hand, for the FFT stages and the spectrum products
+        // built on them: std::complex multiplication goes through the slow NaN-recovery path
+        // without -ffast-math.
+
+        /**
+         * @return a * b
+         */
+        template<std::floating_point T>
+        std::complex<T> multiply(const std::complex<T>& a, const std::complex<T>& b)
+        {
+            return {a.real() * b.real() - a.imag() * b.imag(),
+                    a.real() * b.imag() + a.imag() * b.real()};
+        }
+
+        /**
+         * @return a * conj(b)
+         */
+        template<std::floating_point T>
+        std::complex<T> multiplyConjugate(const std::complex<T>& a, const std::complex<T>& b)
+        {
+            return {a.real() * b.real() + a.imag() * b.imag(),
+                    a.imag() * b.real() - a.real() * b.imag()};
+        }
+    }
+
+    template<std::floating_point T>
+    class BatchPlan;
+
+    /**
+     * Precomputed in-place mixed-radix FFT of a fixed size and direction.
+     *
+     * This is the iterative decimation-in-time algorithm: the input is reordered with a digit
+     * reversal (the repeated interlaced decomposition, see signals::decomposeInterlaced) and then
+     * combined back together with radix-2, 4, 3 and 5 butterfly stages. Any size whose only prime
+     * factors are 2, 3 and 5 is supported.
+     *
+     * The permutation, stage layout and twiddle factors are computed once at construction,
+     * so a plan should be kept around and reused for every transform of the same size.
+     * The inverse transform is scaled by 1/N so that inverse(forward(x)) == x.
+     * @tparam T The floating point precision of the transform.
+     */
+    template<std::floating_point T>
+    class Plan
+    {
+    public:
+        Plan(int size, Direction direction)
+            : Plan(size, direction, factorize(size))
+        {
+        }
+
+        /**
+         * Builds a plan with an explicit stage layout, e.g. one restored from saved wisdom.
+         * @param radices The butterfly radix of each stage, in execution order. Each must be
+         *                2, 3, 4 or 5 and their product must equal `size`.
+         */
+        Plan(int size, Direction direction, const std::vector<int>& radices)
+            : _size(size), _direction(direction)
+        {
+            if (!isSupportedSize(size))
+            {
+                throw std::invalid_argument("dsp::fft::Plan: size must only have prime factors 2, 3 and 5");
+            }
+            int product = 1;
+            for (int radix : radices)
+            {
+                if (radix < 2 || radix > 5)
+                {
+                    throw std::invalid_argument("dsp::fft::Plan: radices must be 2, 3, 4 or 5");
+                }
+                product *= radix;
+            }
+            if (product != size)
+            {
+                throw std::invalid_argument("dsp::fft::Plan: radices must multiply out to the plan size");
+            }
+            buildStages(radices);
+            buildPermutation();
+        }
+
+        [[nodiscard]] int size() const { return _size; }
+        [[nodiscard]] Direction direction() const { return _direction; }
+
+        /**
+         * @return The butterfly radix of each stage, in execution order.
+         */
+        [[nodiscard]] std::vector<int> radices() const
+        {
+            std::vector<int> radices;
+            for (const Stage& stage : _stages)
+            {
+                radices.push_back(stage.radix);
+            }
+            return radices;
+        }
+
+        /**
+         * Transforms `data` in place. `data` must hold exactly size() samples.
+         */
+        void execute(std::span<std::complex<T>> data) const
+        {
+            for (const auto& [a, b] : _swaps)
+            {
+                std::swap(data[a], data[b]);
+            }
+
+            for (const Stage& stage : _stages)
+            {
+                switch (stage.radix)
+                {
+                    case 2: runStage<2>(data, stage); break;
+                    case 3: runStage<3>(data, stage); break;
+                    case 4: runStage<4>(data, stage); break;
+                    case 5: runStage<5>(data, stage); break;
+                    default: break;
+                }
+            }
+
+            if (_direction == Direction::Inverse)
+            {
+                const T scale = T(1) / T(_size);
+                for (auto& value : data)
+                {
+                    value *= scale;
+                }
+            }
+        }
+
+    private:
+        // Runs the same stage layout and twiddles across SIMD lanes
+        friend class BatchPlan<T>;
+
+        /**
+         * One butterfly pass. Combines `radix` transforms of `subLength` points into
+         * transforms of subLength * radix points.
+         */
+        struct Stage
+        {
+            int radix;
+            int subLength;
+            int twiddleOffset; // Into _twiddles; (radix - 1) factors per butterfly
+        };
+
+        // Multiplies by -i for forward transforms and +i for inverse transforms
+        std::complex<T> rotate(const std::complex<T>& a) const
+        {
+            return _direction == Direction::Forward ? std::complex<T>{a.imag(), -a.real()}
+                                                    : std::complex<T>{-a.imag(), a.real()};
+        }
+
+        void buildStages(const std::vector<int>& radices)
+        {
+            const T sign = _direction == Direction::Forward ? T(-1) : T(1);
+            int subLength = 1;
+            for (int radix : radices)
+            {
+                const int length = subLength * radix;
+                _stages.push_back({radix, subLength, static_cast<int>(_twiddles.size())});
+                for (int j = 0; j < subLength; ++j)
+                {
+                    for (int q = 1; q < radix; ++q)
+                    {
+                        const T angle = sign * T(2) * std::numbers::pi_v<T> * T(j * q) / T(length);
+                        _twiddles.emplace_back(std::cos(angle), std::sin(angle));
+                    }
+                }
+                subLength = length;
+            }
+
+            _radix3 = {T(-0.5), sign * std::sqrt(T(3)) / T(2)};
+            _radix5[0] = {std::cos(T(2) * std::numbers::pi_v<T> / T(5)), sign * std::sin(T(2) * std::numbers::pi_v<T> / T(5))};
+            _radix5[1] = {std::cos(T(4) * std::numbers::pi_v<T> / T(5)), sign * std::sin(T(4) * std::numbers::pi_v<T> / T(5))};
+        }
+
+        /**
+         * Digit reversal for the mixed radix decomposition, stored as a list of swaps so
+         * it can be applied in place.
+         */
+        void buildPermutation()
+        {
+            // Input sample i lands at position target[i]. The last stage splits the input into
+            // `radix` interlaced subsequences, the stage before that splits each of those again, etc.
+            std::vector<int> source(_size);
+            for (int i = 0; i < _size; ++i)
+            {
+                int remainder = i;
+                int length = _size;
+                int position = 0;
+                for (auto stage = _stages.rbegin(); stage != _stages.rend(); ++stage)
+                {
+                    length /= stage->radix;
+                    position += (remainder % stage->radix) * length;
+                    remainder /= stage->radix;
+                }
+                source[position] = i;
+            }
+
+            // Replay the permutation on an index array to turn it into swaps
+            std::vector<int> current(_size);
+            std::vector<int> location(_size);
+            for (int i = 0; i < _size; ++i)
+            {
+                current[i] = i;
+                location[i] = i;
+            }
+            for (int position = 0; position < _size; ++position)
+            {
+                const int from = location[source[position]];
+                if (from != position)
+                {
+                    _swaps.emplace_back(position, from);
+                    std::swap(current[position], current[from]);
+                    location[current[position]] = position;
+                    location[current[from]] = from;
+                }
+            }
+        }
+
+        template<int Radix>
+        void runStage(std::span<std::complex<T>> data, const Stage& stage) const
+        {
+            const int m = stage.subLength;
+            const int length = m * Radix;
+            const std::complex<T>* twiddles = _twiddles.data() + stage.twiddleOffset;
+            std::complex<T> a[Radix];
+
+            for (int block = 0; block < _size; block += length)
+            {
+                for (int j = 0; j < m; ++j)
+                {
+                    std::complex<T>* base = data.data() + block + j;
+                    a[0] = base[0];
+                    for (int q = 1; q < Radix; ++q)
+                    {
+                        // The first stage always has m == 1, where every twiddle is 1
+                        a[q] = m == 1 ? base[q * m] : detail::multiply(base[q * m], twiddles[j * (Radix - 1) + q - 1]);
+                    }
+                    butterfly<Radix>(a);
+                    for (int k = 0; k < Radix; ++k)
+                    {
+                        base[k * m] = a[k];
+                    }
+                }
+            }
+        }
+
+        template<int Radix>
+        void butterfly(std::complex<T>* a) const
+        {
+            if constexpr (Radix == 2)
+            {
+                const std::complex<T> t = a[1];
+                a[1] = a[0] - t;
+                a[0] = a[0] + t;
+            }
+            else if constexpr (Radix == 4)
+            {
+                const std::complex<T> t0 = a[0] + a[2];
+                const std::complex<T> t1 = a[0] - a[2];
+                const std::complex<T> t2 = a[1] + a[3];
+                const std::complex<T> t3 = rotate(a[1] - a[3]);
+                a[0] = t0 + t2;
+                a[1] = t1 + t3;
+                a[2] = t0 - t2;
+                a[3] = t1 - t3;
+            }
+            else if constexpr (Radix == 3)
+            {
+                const std::complex<T> s = a[1] + a[2];
+                const std::complex<T> d = a[1] - a[2];
+                const std::complex<T> m = a[0] + _radix3.real() * s;
+                const std::complex<T> r = {-_radix3.imag() * d.imag(), _radix3.imag() * d.real()}; // i * sin * d
+                a[0] = a[0] + s;
+                a[1] = m + r;
+                a[2] = m - r;
+            }
+            else if constexpr (Radix == 5)
+            {
+                const T c1 = _radix5[0].real();
+                const T s1 = _radix5[0].imag();
+                const T c2 = _radix5[1].real();
+                const T s2 = _radix5[1].imag();
+                const std::complex<T> b1 = a[1] + a[4];
+                const std::complex<T> b2 = a[2] + a[3];
+                const std::complex<T> d1 = a[1] - a[4];
+                const std::complex<T> d2 = a[2] - a[3];
+                const std::complex<T> m1 = a[0] + c1 * b1 + c2 * b2;
+                const std::complex<T> m2 = a[0] + c2 * b1 + c1 * b2;
+                const std::complex<T> n1 = s1 * d1 + s2 * d2;
+                const std::complex<T> n2 = s2 * d1 - s1 * d2;
+                const std::complex<T> r1 = {-n1.imag(), n1.real()}; // i * n1
+                const std::complex<T> r2 = {-n2.imag(), n2.real()}; // i * n2
+                a[0] = a[0] + b1 + b2;
+                a[1] = m1 + r1;
+                a[2] = m2 + r2;
+                a[3] = m2 - r2;
+                a[4] = m1 - r1;
+            }
+        }
+
+        int _size;
+        Direction _direction;
+        std::vector<Stage> _stages;
+        std::vector<std::pair<int, int>> _swaps;
+        std::vector<std::complex<T>> _twiddles;
+        std::complex<T> _radix3;    // (cos, +-sin) of 2pi/3
+        std::complex<T> _radix5[2]; // (cos, +-sin) of 2pi/5 and 4pi/5
+    };
+}
+
+#endif //SIGNAL_PROCESSING_BOOK_FFT_H
@@ -0,0 +1,222 @@
+#ifndef SIGNAL_PROCESSING_BOOK_LARGE_FFT_H
+#define SIGNAL_PROCESSING_BOOK_LARGE_FFT_H
+
+#include "libdsp/fft/plan_cache.h"
+#include "libdsp/platform/thread_pool.h"
+
+#include <algorithm>
+#include <complex>
+#include <concepts>
+#include <memory>
+#include <numbers>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace dsp::fft
+{
+    /**
+     * FFT for transforms too large to fit in cache, using the six-step (matrix transpose)
+     * decomposition of N = N1 * N2:
+     *   1. Transpose the input from N1 x N2 to N2 x N1
+     *   2. N2 independent FFTs of length N1 over the rows
+     *   3. Multiply by the twiddle factors W_N^(n2 * k1)
+     *   4. Transpose to N1 x N2
+     *   5. N1 independent FFTs of length N2 over the rows
+     *   6. Transpose back to N2 x N1, which is the output in natural order
+     *
+     * Every FFT pass works on a contiguous row of ~sqrt(N) samples that fits in cache, instead
+     * of striding across the whole array like a textbook radix-2 FFT does at large N. The
+     * transposes are cache-blocked, and both the transposes and the row FFTs are spread across
+     * a ThreadPool.
+     *
+     * Same conventions as Plan: supports sizes with only prime factors 2, 3 and 5, and the
+     * inverse transform is scaled by 1/N.
+     * @tparam T The floating point precision of the transform (float or double).
+     */
+    template<std::floating_point T>
+    class LargePlan
+    {
+    public:
+        /**
+         * Rough size above which a transform stops fitting in a typical per-core L2 cache and
+         * the six-step decomposition beats a single Plan.
+         */
+        static constexpr size_t CACHE_BYTES = 512 * 1024;
+
+        /**
+         * @return True if a transform of `size` points is big enough to benefit from LargePlan.
+         */
+        static constexpr bool exceedsCache(int size)
+        {
+            return static_cast<size_t>(size) * sizeof(std::complex<T>) > CACHE_BYTES;
+        }
+
+        /**
+         * @param size The transform size. Must only have prime factors 2, 3 and 5.
+         * @param direction The transform direction.
+         * @param pool The threads to run the row FFTs and transposes on.
+         */
+        LargePlan(int size, Direction direction, platform::ThreadPool& pool = platform::ThreadPool::shared())
+            : _size(size), _direction(direction), _pool(pool)
+        {
+            if (!isSupportedSize(size))
+            {
+                throw std::invalid_argument("dsp::fft::LargePlan: size must only have prime factors 2, 3 and 5");
+            }
+
+            // Most square split: the largest divisor of N that is <= sqrt(N)
+            _rows = 1;
+            for (int d = 1; static_cast<long long>(d) * d <= size; ++d)
+            {
+                if (size % d == 0)
+                {
+                    _rows = d;
+                }
+            }
+            _columns = size / _rows;
+
+            _rowPlan = PlanCache::instance().complexPlan<T>(_rows, direction);
+            _columnPlan = PlanCache::instance().complexPlan<T>(_columns, direction);
+
+            // W_N^(n2 * k1), laid out as N2 rows of N1 factors to match step 3
+            // Angles are always computed in double; single precision loses too much at these sizes
+            const double sign = direction == Direction::Forward ? -1.0 : 1.0;
+            _twiddles.resize(size);
+            for (int n2 = 0; n2 < _columns; ++n2)
+            {
+                for (int k1 = 0; k1 < _rows; ++k1)
+                {
+                    const long long exponent = (static_cast<long long>(n2) * k1) % size;
+                    const double angle = sign * 2.0 * std::numbers::pi * static_cast<double>(exponent) / size;
+                    _twiddles[static_cast<size_t>(n2) * _rows + k1] = {static_cast<T>(std::cos(angle)), static_cast<T>(std::sin(angle))};
+                }
+            }
+        }
+
+        [[nodiscard]] int size() const { return _size; }
+        [[nodiscard]] Direction direction() const { return _direction; }
+
+        /**
+         * Transforms `data` in place. `data` must hold exactly size() samples.
+         * Square splits (N an even power of 2, 3 or 5, etc.) are transposed in place; otherwise a
+         * size() sample scratch buffer is allocated per call.
+         */
+        void execute(std::span<std::complex<T>> data) const
+        {
+            const int n1 = _rows;
+            const int n2 = _columns;
+            std::vector<std::complex<T>> scratch(n1 == n2 ? 0 : _size);
+            std::complex<T>* rowsFirst = n1 == n2 ? data.data() : scratch.data();
+
+            transpose(data.data(), rowsFirst, n1, n2);
+
+            _pool.parallelFor(n2, rowGrain(n1), [&](int begin, int end) {
+                for (int row = begin; row < end; ++row)
+                {
+                    std::span<std::complex<T>> samples(rowsFirst + static_cast<size_t>(row) * n1, n1);
+                    _rowPlan->execute(samples);
+                    const std::complex<T>* twiddles = _twiddles.data() + static_cast<size_t>(row) * n1;
+                    for (int k = 0; k < n1; ++k)
+                    {
+                        samples[k] = detail::multiply(samples[k], twiddles[k]);
+                    }
+                }
+            });
+
+            transpose(rowsFirst, data.data(), n2, n1);
+
+            _pool.parallelFor(n1, rowGrain(n2), [&](int begin, int end) {
+                for (int row = begin; row < end; ++row)
+                {
+                    _columnPlan->execute(data.subspan(static_cast<size_t>(row) * n2, n2));
+                }
+            });
+
+            transpose(data.data(), rowsFirst, n1, n2);
+            if (rowsFirst != data.data())
+            {
+                std::copy(scratch.begin(), scratch.end(), data.begin());
+            }
+        }
+
+    private:
+        static constexpr int TILE = 32;
+
+        // Enough rows per task to amortize scheduling, roughly 64K samples each
+        static int rowGrain(int rowLength)
+        {
+            return std::max(1, (64 * 1024) / rowLength);
+        }
+
+        /**
+         * Transpose of a rows x columns matrix, in TILE x TILE blocks so that both the reads and the
+         * writes stay within a few cache lines at a time. `in` and `out` may only alias for a square matrix.
+         */
+        void transpose(const std::complex<T>* in, std::complex<T>* out, int rows, int columns) const
+        {
+            if (in == out)
+            {
+                transposeSquareInPlace(out, rows);
+                return;
+            }
+
+            const int tileRows = (rows + TILE - 1) / TILE;
+            _pool.parallelFor(tileRows, std::max(1, tileRows / 64), [&](int begin, int end) {
+                for (int tileRow = begin; tileRow < end; ++tileRow)
+                {
+                    const int r0 = tileRow * TILE;
+                    const int r1 = std::min(rows, r0 + TILE);
+                    for (int c0 = 0; c0 < columns; c0 += TILE)
+                    {
+                        const int c1 = std::min(columns, c0 + TILE);
+                        for (int r = r0; r < r1; ++r)
+                        {
+                            for (int c = c0; c < c1; ++c)
+                            {
+                                out[static_cast<size_t>(c) * rows + r] = in[static_cast<size_t>(r) * columns + c];
+                            }
+                        }
+                    }
+                }
+            });
+        }
+
+        /**
+         * Swaps each tile above the diagonal with its mirror below it, so no scratch space is needed.
+         */
+        void transposeSquareInPlace(std::complex<T>* data, int n) const
+        {
+            const int tiles = (n + TILE - 1) / TILE;
+            _pool.parallelFor(tiles, std::max(1, tiles / 64), [&](int begin, int end) {
+                for (int tileRow = begin; tileRow < end; ++tileRow)
+                {
+                    const int r0 = tileRow * TILE;
+                    const int r1 = std::min(n, r0 + TILE);
+                    for (int c0 = r0; c0 < n; c0 += TILE)
+                    {
+                        const int c1 = std::min(n, c0 + TILE);
+                        for (int r = r0; r < r1; ++r)
+                        {
+                            for (int c = std::max(c0, r + 1); c < c1; ++c)
+                            {
+                                std::swap(data[static_cast<size_t>(r) * n + c], data[static_cast<size_t>(c) * n + r]);
+                            }
+                        }
+                    }
+                }
+            });
+        }
+
+        int _size;
+        Direction _direction;
+        platform::ThreadPool& _pool;
+        int _rows = 1;
+        int _columns = 1;
+        std::shared_ptr<const Plan<T>> _rowPlan;
+        std::shared_ptr<const Plan<T>> _columnPlan;
+        std::vector<std::complex<T>> _twiddles;
+    };
+}
+
+#endif //SIGNAL_PROCESSING_BOOK_LARGE_FFT_H
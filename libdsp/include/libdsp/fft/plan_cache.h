@@ -0,0 +1,96 @@
+#ifndef SIGNAL_PROCESSING_BOOK_PLAN_CACHE_H
+#define SIGNAL_PROCESSING_BOOK_PLAN_CACHE_H
+
+#include "libdsp/fft/fft.h"
+#include "libdsp/fft/real_fft.h"
+
+#include <compare>
+#include <concepts>
+#include <functional>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <variant>
+
+namespace dsp::fft
+{
+    enum class TransformType
+    {
+        Complex,
+        Real
+    };
+
+    enum class Precision
+    {
+        Single,
+        Double
+    };
+
+    /**
+     * Process-wide cache of FFT plans, keyed by (size, type, direction, precision).
+     *
+     * Plans are immutable once built, so the returned plans can be shared and executed from any
+     * number of threads. Lookups take a shared lock; a miss builds the plan outside the lock
+     * and publishes it, so concurrent first calls never block each other on plan setup.
+     *
+     * The set of cached plans can be saved as "wisdom" and reloaded on startup, which builds every
+     * plan a previous run needed up front instead of on the first transform at each size.
+     * Only float and double plans are cached.
+     */
+    class PlanCache
+    {
+    public:
+        static PlanCache& instance();
+
+        PlanCache() = default;
+        PlanCache(const PlanCache&) = delete;
+        PlanCache& operator=(const PlanCache&) = delete;
+
+        template<std::floating_point T>
+        std::shared_ptr<const Plan<T>> complexPlan(int size, Direction direction);
+
+        template<std::floating_point T>
+        std::shared_ptr<const RealPlan<T>> realPlan(int size, Direction direction);
+
+        /**
+         * Writes the key and stage layout of every cached plan to `path`.
+         * @return False if the file could not be written.
+         */
+        bool saveWisdom(const std::string& path) const;
+
+        /**
+         * Reads wisdom written by saveWisdom() and builds every plan it lists that isn't cached yet.
+         * Lines that don't describe a valid plan are skipped.
+         * @return False if the file could not be read, isn't a wisdom file, or had invalid lines.
+         */
+        bool loadWisdom(const std::string& path);
+
+        [[nodiscard]] size_t size() const;
+        void clear();
+
+    private:
+        struct Key
+        {
+            int size;
+            TransformType type;
+            Direction direction;
+            Precision precision;
+
+            auto operator<=>(const Key&) const = default;
+        };
+
+        using Entry = std::variant<std::shared_ptr<const Plan<float>>,
+                                   std::shared_ptr<const Plan<double>>,
+                                   std::shared_ptr<const RealPlan<float>>,
+                                   std::shared_ptr<const RealPlan<double>>>;
+
+        template<typename PlanT>
+        std::shared_ptr<const PlanT> lookupOrInsert(const Key& key, const std::function<std::shared_ptr<const PlanT>()>& build);
+
+        mutable std::shared_mutex _mutex;
+        std::map<Key, Entry> _plans;
+    };
+}
+
+#endif //SIGNAL_PROCESSING_BOOK_PLAN_CACHE_H
@@ -0,0 +1,171 @@
+#ifndef SIGNAL_PROCESSING_BOOK_REAL_FFT_H
+#define SIGNAL_PROCESSING_BOOK_REAL_FFT_H
+
+#include "libdsp/fft/fft.h"
+
+#include <complex>
+#include <concepts>
+#include <numbers>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace dsp::fft
+{
+    /**
+     * Precomputed FFT of a real signal of N samples (N even).
+     *
+     * The N real samples are packed into N/2 complex samples (even samples as the real part,
+     * odd samples as the imaginary part), transformed with an N/2 point complex Plan, and then
+     * separated back out with a post-twiddle pass. This does roughly half the work of a
+     * complex transform of the same length.
+     *
+     * Only the N/2 + 1 non-redundant bins of the Hermitian spectrum are stored:
+     * X[N - k] == conj(X[k]) for a real input.
+     * The inverse transform is scaled by 1/N so that inverse(forward(x)) == x.
+     * @tparam T The floating point precision of the transform.
+     */
+    template<std::floating_point T>
+    class RealPlan
+    {
+    public:
+        RealPlan(int size, Direction direction)
+            : RealPlan(size, direction, factorize(size / 2))
+        {
+        }
+
+        /**
+         * Builds a plan with an explicit stage layout, e.g. one restored from saved wisdom.
+         * @param radices The stage radices of the inner N/2 point complex transform.
+         */
+        RealPlan(int size, Direction direction, const std::vector<int>& radices)
+            : _size(size), _direction(direction), _half(size / 2, direction, radices)
+        {
+            if (size % 2 != 0)
+            {
+                throw std::invalid_argument("dsp::fft::RealPlan: size must be even");
+            }
+
+            // The post-twiddle always uses the forward rotation e^{-2 pi i k / N}; the inverse
+            // pass conjugates it as part of the unpacking.
+            const int half = size / 2;
+            _twiddles.resize(half);
+            for (int k = 0; k < half; ++k)
+            {
+                const T angle = -T(2) * std::numbers::pi_v<T> * T(k) / T(size);
+                _twiddles[k] = {std::cos(angle), std::sin(angle)};
+            }
+        }
+
+        [[nodiscard]] int size() const { return _size; }
+        [[nodiscard]] int spectrumSize() const { return _size / 2 + 1; }
+        [[nodiscard]] Direction direction() const { return _direction; }
+        [[nodiscard]] std::vector<int> radices() const { return _half.radices(); }
+
+        /**
+         * Real-to-complex forward transform. Requires a Forward plan.
+         * @param input size() real samples
+         * @param output spectrumSize() complex bins (0 through N/2 inclusive)
+         */
+        void execute(std::span<const T> input, std::span<std::complex<T>> output) const
+        {
+            if (_direction != Direction::Forward)
+            {
+                throw std::logic_error("dsp::fft::RealPlan: real-to-complex transform needs a Forward plan");
+            }
+
+            const int half = _size / 2;
+            for (int k = 0; k < half; ++k)
+            {
+                output[k] = {input[2 * k], input[2 * k + 1]};
+            }
+            _half.execute(output.first(half));
+
+            // Split Z[k] back into the spectra of the even and odd samples and recombine them:
+            //   E[k] = (Z[k] + conj(Z[N/2 - k])) / 2
+            //   O[k] = -i * (Z[k] - conj(Z[N/2 - k])) / 2
+            //   X[k] = E[k] + e^{-2 pi i k / N} O[k]
+            const std::complex<T> z0 = output[0];
+            output[0] = {z0.real() + z0.imag(), T(0)};
+            output[half] = {z0.real() - z0.imag(), T(0)};
+            for (int k = 1; k <= half / 2; ++k)
+            {
+                const std::complex<T> a = output[k];
+                const std::complex<T> b = output[half - k];
+                output[k] = unpack(a, b, _twiddles[k]);
+                if (k != half - k)
+                {
+                    output[half - k] = unpack(b, a, _twiddles[half - k]);
+                }
+            }
+        }
+
+        /**
+         * Complex-to-real inverse transform. Requires an Inverse plan. The imaginary parts of
+         * the DC and Nyquist bins are ignored.
+         * @param input spectrumSize() complex bins (0 through N/2 inclusive)
+         * @param output size() real samples
+         */
+        void execute(std::span<const std::complex<T>> input, std::span<T> output) const
+        {
+            if (_direction != Direction::Inverse)
+            {
+                throw std::logic_error("dsp::fft::RealPlan: complex-to-real transform needs an Inverse plan");
+            }
+
+            // The output storage doubles as the packed N/2 point complex work buffer. std::complex
+            // is guaranteed to be laid out as two consecutive T values.
+            const int half = _size / 2;
+            std::span<std::complex<T>> packed(reinterpret_cast<std::complex<T>*>(output.data()), half);
+
+            //   E[k] = (X[k] + conj(X[N/2 - k])) / 2
+            //   O[k] = (X[k] - conj(X[N/2 - k])) / 2 * e^{2 pi i k / N}
+            //   Z[k] = E[k] + i * O[k]
+            // DC and Nyquist are purely real and both map onto Z[0]
+            packed[0] = {(input[0].real() + input[half].real()) * T(0.5),
+                         (input[0].real() - input[half].real()) * T(0.5)};
+            for (int k = 1; k <= half / 2; ++k)
+            {
+                const std::complex<T> a = input[k];
+                const std::complex<T> b = input[half - k];
+                packed[k] = repack(a, b, _twiddles[k]);
+                if (k != half - k)
+                {
+                    packed[half - k] = repack(b, a, _twiddles[half - k]);
+                }
+            }
+            _half.execute(packed);
+        }
+
+    private:
+        static std::complex<T> unpack(const std::complex<T>& a, const std::complex<T>& b, const std::complex<T>& w)
+        {
+            const T er = (a.real() + b.real()) * T(0.5);
+            const T ei = (a.imag() - b.imag()) * T(0.5);
+            // -i * (a - conj(b)) / 2
+            const T or_ = (a.imag() + b.imag()) * T(0.5);
+            const T oi = -(a.real() - b.real()) * T(0.5);
+            return {er + w.real() * or_ - w.imag() * oi,
+                    ei + w.real() * oi + w.imag() * or_};
+        }
+
+        static std::complex<T> repack(const std::complex<T>& a, const std::complex<T>& b, const std::complex<T>& w)
+        {
+            const T er = (a.real() + b.real()) * T(0.5);
+            const T ei = (a.imag() - b.imag()) * T(0.5);
+            const T dr = (a.real() - b.real()) * T(0.5);
+            const T di = (a.imag() + b.imag()) * T(0.5);
+            // O = d * conj(w), Z = E + i * O
+            const T or_ = dr * w.real() + di * w.imag();
+            const T oi = di * w.real() - dr * w.imag();
+            return {er - oi, ei + or_};
+        }
+
+        int _size;
+        Direction _direction;
+        Plan<T> _half;
+        std::vector<std::complex<T>> _twiddles;
+    };
+}
+
+#endif //SIGNAL_PROCESSING_BOOK_REAL_FFT_H
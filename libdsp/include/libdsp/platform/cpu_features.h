@@ -0,0 +1,47 @@
+#ifndef SIGNAL_PROCESSING_BOOK_CPU_FEATURES_H
+#define SIGNAL_PROCESSING_BOOK_CPU_FEATURES_H
+
+namespace dsp::platform
+{
+    /**
+     * SIMD instruction sets the host CPU (and OS) can actually run.
+     */
+    struct CpuFeatures
+    {
+        bool sse2 = false;
+        bool avx2 = false;
+        bool fma = false;
+        bool avx512f = false;
+        bool avx512bw = false;
+        bool neon = false;
+    };
+
+    /**
+     * Vector instruction set used by a runtime-dispatched kernel.
+     */
+    enum class SimdLevel
+    {
+        Scalar,
+        SSE2,
+        AVX2,   // AVX2 + FMA
+        AVX512, // AVX-512F
+        NEON
+    };
+
+    /**
+     * Detects the host's CPU features once and caches the result.
+     */
+    const CpuFeatures& cpuFeatures();
+
+    /**
+     * @return True if the host can run kernels built for `level`.
+     */
+    bool isSupported(SimdLevel level);
+
+    /**
+     * @return The widest SimdLevel the host supports.
+     */
+    SimdLevel bestSimdLevel();
+}
+
+#endif //SIGNAL_PROCESSING_BOOK_CPU_FEATURES_H
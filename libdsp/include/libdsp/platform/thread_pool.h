@@ -0,0 +1,58 @@
+#ifndef SIGNAL_PROCESSING_BOOK_THREAD_POOL_H
+#define SIGNAL_PROCESSING_BOOK_THREAD_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dsp::platform
+{
+    /**
+     * Fixed-size pool of worker threads for splitting loops over independent work items.
+     *
+     * The thread calling parallelFor() always works on the loop too, so a pool with zero workers
+     * simply runs everything inline, and nested parallelFor() calls can't deadlock.
+     */
+    class ThreadPool
+    {
+    public:
+        /**
+         * @param workerCount Number of worker threads to start, in addition to the calling thread.
+         */
+        explicit ThreadPool(int workerCount);
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool(ThreadPool&&) = delete;
+        ~ThreadPool();
+
+        /**
+         * Process-wide pool with one worker per hardware thread, minus one for the caller.
+         */
+        static ThreadPool& shared();
+
+        [[nodiscard]] int workerCount() const { return static_cast<int>(_workers.size()); }
+
+        /**
+         * Calls fn(begin, end) over [0, count) in chunks of at most `grain` items, spread across the
+         * workers and the calling thread. Blocks until every chunk has finished. If any chunk throws,
+         * the first exception is rethrown here once all chunks are done.
+         */
+        void parallelFor(int count, int grain, const std::function<void(int begin, int end)>& fn);
+
+    private:
+        struct Job;
+
+        void workerLoop();
+
+        std::vector<std::thread> _workers;
+        std::deque<std::shared_ptr<Job>> _jobs;
+        std::mutex _mutex;
+        std::condition_variable _wake;
+        bool _stopping = false;
+    };
+}
+
+#endif //SIGNAL_PROCESSING_BOOK_THREAD_POOL_H
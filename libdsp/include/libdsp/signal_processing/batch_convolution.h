@@ -0,0 +1,225 @@
+#ifndef SIGNAL_PROCESSING_BOOK_BATCH_CONVOLUTION_H
+#define SIGNAL_PROCESSING_BOOK_BATCH_CONVOLUTION_H
+
+#include "libdsp/platform/thread_pool.h"
+#include "libdsp/signal_processing/convolution_planner.h"
+#include "libdsp/signal_processing/direct_convolution.h"
+#include "libdsp/signal_processing/fast_convolution.h"
+#include "libdsp/signal_processing/signal_processing.h"
+#include "libdsp/signal_processing/sparse_impulse_response.h"
+#include "libdsp/storage/buffer2d.h"
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace dsp::signals
+{
+    namespace detail
+    {
+        // A direct-form batch task: BATCH_TILE outputs of BATCH_CHANNEL_GROUP channels, with the
+        // taps applied BATCH_TAP_BLOCK at a time. A tap block is reused across every channel of
+        // the group while it is still in L1, and each channel's input segment across every tap block.
+        constexpr int BATCH_TILE = 2048;
+        constexpr int BATCH_CHANNEL_GROUP = 4;
+        constexpr int BATCH_TAP_BLOCK = 1024;
+
+        template<std::floating_point T>
+        void checkBatch(std::span<const std::span<const T>> inputs, std::span<const T> h, std::span<const std::span<T>> outputs)
+        {
+            if (h.empty() || inputs.size() != outputs.size())
+            {
+                throw std::invalid_argument("dsp::signals::convolveBatch: need an impulse response and one output per input");
+            }
+            for (size_t c = 0; c < inputs.size(); ++c)
+            {
+                if (outputs[c].size() != inputs[c].size() + h.size() - 1)
+                {
+                    throw std::invalid_argument("dsp::signals::convolveBatch: each output must hold N + M - 1 samples");
+                }
+            }
+        }
+
+        template<std::floating_point T>
+        void convolveBatchDirect(std::span<const std::span<const T>> inputs, std::span<const T> h,
+                                 std::span<const std::span<T>> outputs, platform::ThreadPool& pool)
+        {
+            const int channels = static_cast<int>(inputs.size());
+            const int m = static_cast<int>(h.size());
+            size_t longest = 0;
+            for (const auto& output : outputs)
+            {
+                longest = std::max(longest, output.size());
+            }
+            const int tiles = static_cast<int>((longest + BATCH_TILE - 1) / BATCH_TILE);
+            const int groups = (channels + BATCH_CHANNEL_GROUP - 1) / BATCH_CHANNEL_GROUP;
+
+            pool.parallelFor(groups * tiles, 1, [&](int begin, int end) {
+                const int segment = BATCH_TILE + m - 1;
+                std::vector<T> padded(static_cast<size_t>(BATCH_CHANNEL_GROUP) * segment);
+                std::vector<T> scratch(BATCH_TILE);
+                for (int task = begin; task < end; ++task)
+                {
+                    const int c0 = (task / tiles) * BATCH_CHANNEL_GROUP;
+                    const int c1 = std::min(channels, c0 + BATCH_CHANNEL_GROUP);
+                    const int first = (task % tiles) * BATCH_TILE;
+
+                    // segments[c - c0][t] = x[first - (M - 1) + t], so output first + i reads [i, i + M).
+                    // Tiles that lie inside the input read it in place; only the edges are zero-padded
+                    std::array<const T*, BATCH_CHANNEL_GROUP> segments{};
+                    for (int c = c0; c < c1; ++c)
+                    {
+                        const int start = first - m + 1;
+                        if (start >= 0 && start + segment <= static_cast<int>(inputs[c].size()))
+                        {
+                            segments[c - c0] = inputs[c].data() + start;
+                        }
+                        else if (first < static_cast<int>(outputs[c].size()))
+                        {
+                            T* dest = padded.data() + static_cast<size_t>(c - c0) * segment;
+                            copyPadded(inputs[c], start, segment, dest);
+                            segments[c - c0] = dest;
+                        }
+                    }
+
+                    for (int k0 = 0; k0 < m; k0 += BATCH_TAP_BLOCK)
+                    {
+                        const int k1 = std::min(m, k0 + BATCH_TAP_BLOCK);
+                        const int taps = k1 - k0;
+                        for (int c = c0; c < c1; ++c)
+                        {
+                            const int width = std::min(BATCH_TILE, static_cast<int>(outputs[c].size()) - first);
+                            if (width <= 0)
+                            {
+                                continue;
+                            }
+                            // Taps [k0, k1) read segment[i + M - k1, i + M - k0)
+                            const T* in = segments[c - c0] + (m - k1);
+                            T* out = outputs[c].data() + first;
+                            if (k0 == 0)
+                            {
+                                convolveValid(in, width + taps - 1, h.data(), taps, out);
+                                continue;
+                            }
+                            convolveValid(in, width + taps - 1, h.data() + k0, taps, scratch.data());
+                            for (int i = 0; i < width; ++i)
+                            {
+                                out[i] += scratch[i];
+                            }
+                        }
+                    }
+                }
+            });
+        }
+
+        template<std::floating_point T>
+        void convolveBatchFft(std::span<const std::span<const T>> inputs, std::span<const T> h,
+                              std::span<const std::span<T>> outputs, platform::ThreadPool& pool)
+        {
+            const int m = static_cast<int>(h.size());
+            size_t longest = 0;
+            for (const auto& input : inputs)
+            {
+                longest = std::max(longest, input.size());
+            }
+
+            // One convolver, so the kernel is transformed once. convolve() is const and allocates its
+            // own scratch, so every thread can share it
+            const int fftSize = std::min(fft::nextPowerOfTwo(std::max(16, 4 * m)),
+                                         fft::nextPowerOfTwo(static_cast<int>(std::max<size_t>(1, longest)) + m));
+            const FftConvolver<T> convolver(h, BlockMode::OverlapSave, fftSize);
+            pool.parallelFor(static_cast<int>(inputs.size()), 1, [&](int begin, int end) {
+                for (int c = begin; c < end; ++c)
+                {
+                    convolver.convolve(inputs[c], outputs[c]);
+                }
+            });
+        }
+    }
+
+    /**
+     * Convolves many signals with the same impulse response, e.g. every channel of a sensor array
+     * through one FIR. Output c is inputs[c] convolved with h (N_c + M - 1 samples).
+     *
+     * Direct strategies work on tiles of a few channels by a few thousand outputs, spread across
+     * `pool`, with the taps applied in blocks that each channel of the tile reuses while they are
+     * in cache. FFT strategies transform h once and share that spectrum across all channels. Sparse
+     * extracts the non-zero taps of h once and runs one channel per task.
+     * @param strategy How to convolve. Partitioned is treated as Fft, since whole signals are known.
+     * @param pool The threads to run on.
+     */
+    template<std::floating_point T>
+    void convolveBatch(ConvolutionStrategy strategy, std::span<const std::span<const T>> inputs, std::span<const T> h,
+                       std::span<const std::span<T>> outputs, platform::ThreadPool& pool = platform::ThreadPool::shared())
+    {
+        detail::checkBatch(inputs, h, outputs);
+        if (inputs.empty())
+        {
+            return;
+        }
+        if (strategy == ConvolutionStrategy::Direct || strategy == ConvolutionStrategy::SimdDirect)
+        {
+            detail::convolveBatchDirect(inputs, h, outputs, pool);
+        }
+        else if (strategy == ConvolutionStrategy::Sparse)
+        {
+            const SparseImpulseResponse<T> sparse(h);
+            pool.parallelFor(static_cast<int>(inputs.size()), 1, [&](int begin, int end) {
+                for (int c = begin; c < end; ++c)
+                {
+                    convolveSparse(inputs[c].data(), static_cast<int>(inputs[c].size()), sparse.offsets().data(), sparse.gains().data(),
+                                   sparse.tapCount(), outputs[c].data(), 0, static_cast<int>(outputs[c].size()));
+                }
+            });
+        }
+        else
+        {
+            detail::convolveBatchFft(inputs, h, outputs, pool);
+        }
+    }
+
+    /**
+     * convolveBatch() with Sparse if h is sparse enough (as in convolve()), and otherwise the
+     * strategy ConvolutionPlanner picks for the longest input and h.
+     */
+    template<std::floating_point T>
+    void convolveBatch(std::span<const std::span<const T>> inputs, std::span<const T> h, std::span<const std::span<T>> outputs,
+                       platform::ThreadPool& pool = platform::ThreadPool::shared())
+    {
+        size_t longest = 0;
+        for (const auto& input : inputs)
+        {
+            longest = std::max(longest, input.size());
+        }
+        const auto precision = std::same_as<T, float> ? fft::Precision::Single : fft::Precision::Double;
+        const auto strategy = detail::preferSparse(h)
+                ? ConvolutionStrategy::Sparse
+                : ConvolutionPlanner::instance().choose(static_cast<int>(longest), static_cast<int>(h.size()), precision);
+        convolveBatch(strategy, inputs, h, outputs, pool);
+    }
+
+    /**
+     * Batch convolution of a multichannel buffer with one row per channel.
+     * @return channels x (N + M - 1) outputs, row c being row c of `x` convolved with `h`.
+     */
+    template<std::floating_point T>
+    Buffer2D<T> convolveBatch(const Buffer2D<T>& x, std::span<const T> h,
+                              platform::ThreadPool& pool = platform::ThreadPool::shared())
+    {
+        Buffer2D<T> y(x.rows(), h.empty() ? 0 : x.columns() + static_cast<int>(h.size()) - 1);
+        std::vector<std::span<const T>> inputs(x.rows());
+        std::vector<std::span<T>> outputs(x.rows());
+        for (int c = 0; c < x.rows(); ++c)
+        {
+            inputs[c] = x.row(c);
+            outputs[c] = y.row(c);
+        }
+        convolveBatch<T>(inputs, h, outputs, pool);
+        return y;
+    }
+}
+
+#endif //SIGNAL_PROCESSING_BOOK_BATCH_CONVOLUTION_H
@@ -0,0 +1,356 @@
+#ifndef SIGNAL_PROCESSING_BOOK_CIC_FILTER_H
+#define SIGNAL_PROCESSING_BOOK_CIC_FILTER_H
+
+#include "libdsp/signal_processing/windows.h"
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace dsp::signals
+{
+    namespace detail
+    {
+        /**
+         * Checks the parameters of a CIC filter and that its output fits the 64-bit registers.
+         *
+         * The integrators overflow on any input with a DC component, but every stage is linear
+         * modulo 2^64 (unsigned arithmetic wraps, and integer conversions are modulo 2^64 since C++20),
+         * so the wrapped values are harmless as long as the final output fits: with B-bit input, the
+         * gain `log2Gain` must satisfy B + ceil(log2Gain) <= 64 (Hogenauer, 1981).
+         */
+        inline void checkCic(const char* name, int factor, int order, int differentialDelay, int inputBits, double log2Gain)
+        {
+            if (factor < 1 || order < 1 || differentialDelay < 1 || inputBits < 1)
+            {
+                throw std::invalid_argument(std::string("dsp::signals::") + name +
+                                            ": factor, order, differential delay and input bits must be positive");
+            }
+            if (inputBits + static_cast<int>(std::ceil(log2Gain - 1e-9)) > 64)
+            {
+                throw std::invalid_argument(std::string("dsp::signals::") + name +
+                                            ": output would need more than 64 bits; lower the order, factor or input bits");
+            }
+        }
+    }
+
+    /**
+     * Magnitude response of an order-N CIC filter with rate change R and differential delay M,
+     * normalized to unity gain at DC:
+     *   |H(f)| = |sin(pi M f) / (R M sin(pi f / R))|^N
+     * @param frequency In cycles per sample at the low rate (the decimator's output, the
+     *                  interpolator's input), 0 to 0.5.
+     */
+    inline double cicResponse(double frequency, int order, int factor, int differentialDelay = 1)
+    {
+        const double low = std::numbers::pi * frequency / factor;
+        if (std::abs(std::sin(low)) < 1e-15)
+        {
+            return 1.0;
+        }
+        const double ratio = std::sin(std::numbers::pi * differentialDelay * frequency) / (factor * differentialDelay * std::sin(low));
+        return std::pow(std::abs(ratio), order);
+    }
+
+    /**
+     * Streaming cascaded integrator-comb (CIC) decimator: N integrators at the input rate, a
+     * downsampler by R, then N combs y = v[k] - v[k - M] at the output rate. That is the FIR
+     * decimator with h = an R M sample boxcar convolved with itself N times, computed without a
+     * single multiply and at a cost independent of R, which makes it the usual first stage for
+     * decimating by hundreds or thousands. Like FirDecimator, y[k] = \sum_j h[j]x[kR - j], so
+     * the first output lines up with the first input sample.
+     *
+     * The boxcar response droops across the passband and aliases near multiples of the output
+     * rate, so the CIC is normally followed by a short FIR at the output rate: design it with
+     * cicCompensationFilter and run it through FirFilter or FirDecimator on the floating point
+     * outputs, for which process() also has an overload.
+     *
+     * All arithmetic is on wrapping 64-bit registers, so results are exact (see detail::checkCic).
+     * @tparam T The integer input sample type, e.g. the ADC's int16_t or int32_t.
+     */
+    template<std::signed_integral T>
+    class CicDecimator
+    {
+    public:
+        /**
+         * @param factor The decimation factor R. Must be positive.
+         * @param order The number of integrator and comb stages N. Must be positive.
+         * @param differentialDelay The comb delay M in output samples, usually 1 or 2. Must be positive.
+         * @param inputBits Significant bits of the input samples, e.g. 16 for a 16-bit ADC stored in
+         *                  int32_t. Must leave room for the N log2(R M) bits of gain within 64.
+         */
+        CicDecimator(int factor, int order, int differentialDelay = 1, int inputBits = std::numeric_limits<T>::digits + 1)
+            : _factor(factor), _order(order), _delay(differentialDelay)
+        {
+            detail::checkCic("CicDecimator", factor, order, differentialDelay, inputBits,
+                             order * std::log2(static_cast<double>(factor) * differentialDelay));
+            _integrators.resize(order);
+            _combs.resize(static_cast<size_t>(order) * differentialDelay);
+            reset();
+        }
+
+        [[nodiscard]] int factor() const { return _factor; }
+        [[nodiscard]] int order() const { return _order; }
+        [[nodiscard]] int differentialDelay() const { return _delay; }
+
+        /**
+         * @return The DC gain (R M)^N of the integer outputs.
+         */
+        [[nodiscard]] double gain() const { return std::pow(static_cast<double>(_factor) * _delay, _order); }
+
+        /**
+         * @return The most outputs a call to process() with `inputCount` samples can produce.
+         */
+        [[nodiscard]] int maxOutputCount(int inputCount) const
+        {
+            return (inputCount + _factor - 1) / _factor;
+        }
+
+        /**
+         * Clears the integrators and combs and restarts the output phase at the next input sample.
+         */
+        void reset()
+        {
+            std::fill(_integrators.begin(), _integrators.end(), 0);
+            std::fill(_combs.begin(), _combs.end(), 0);
+            _combPosition = 0;
+            _skip = 0;
+        }
+
+        /**
+         * Filters `count` input samples and writes the kept outputs at full precision, with a gain
+         * of gain(). Never allocates.
+         * @param output Room for at least maxOutputCount(count) samples.
+         * @return The number of outputs written.
+         */
+        int process(const T* input, int count, std::int64_t* output)
+        {
+            return run(input, count, [&](int k, std::uint64_t v) { output[k] = static_cast<std::int64_t>(v); });
+        }
+
+        /**
+         * process() with the outputs scaled to unity DC gain, to feed a floating point FIR stage.
+         */
+        template<std::floating_point U>
+        int process(const T* input, int count, U* output)
+        {
+            const double scale = 1.0 / gain();
+            return run(input, count, [&](int k, std::uint64_t v) { output[k] = static_cast<U>(static_cast<double>(static_cast<std::int64_t>(v)) * scale); });
+        }
+
+    private:
+        template<typename Emit>
+        int run(const T* input, int count, const Emit& emit)
+        {
+            int written = 0;
+            for (int i = 0; i < count; ++i)
+            {
+                std::uint64_t v = static_cast<std::uint64_t>(static_cast<std::int64_t>(input[i]));
+                for (std::uint64_t& integrator : _integrators)
+                {
+                    integrator += v;
+                    v = integrator;
+                }
+                if (_skip > 0)
+                {
+                    --_skip;
+                    continue;
+                }
+                _skip = _factor - 1;
+
+                // Comb stage s keeps its last M inputs at _combs[s * M, (s + 1) * M), oldest at _combPosition
+                std::uint64_t* delayed = _combs.data() + _combPosition;
+                for (int s = 0; s < _order; ++s, delayed += _delay)
+                {
+                    const std::uint64_t previous = *delayed;
+                    *delayed = v;
+                    v -= previous;
+                }
+                _combPosition = _combPosition + 1 == _delay ? 0 : _combPosition + 1;
+                emit(written++, v);
+            }
+            return written;
+        }
+
+        int _factor;
+        int _order;
+        int _delay;
+        std::vector<std::uint64_t> _integrators;
+        std::vector<std::uint64_t> _combs;
+        int _combPosition = 0;
+        int _skip = 0; // New samples to skip before the next kept output
+    };
+
+    /**
+     * Streaming CIC interpolator: N combs y = x[m] - x[m - M] at the input rate, an upsampler by R
+     * (zero stuffing), then N integrators at the output rate. The same FIR as CicDecimator, applied
+     * as FirInterpolator would with the same h, again without multiplies.
+     *
+     * Its gain is (R M)^N / R. Precede it with a cicCompensationFilter at the input rate to flatten
+     * the passband and suppress what the boxcar images would leave behind.
+     * @tparam T The integer input sample type.
+     */
+    template<std::signed_integral T>
+    class CicInterpolator
+    {
+    public:
+        /**
+         * @param factor The interpolation factor R. Must be positive.
+         * @param order The number of comb and integrator stages N. Must be positive.
+         * @param differentialDelay The comb delay M in input samples. Must be positive.
+         * @param inputBits Significant bits of the input samples. Must leave room for the
+         *                  log2((R M)^N / R) bits of gain within 64.
+         */
+        CicInterpolator(int factor, int order, int differentialDelay = 1, int inputBits = std::numeric_limits<T>::digits + 1)
+            : _factor(factor), _order(order), _delay(differentialDelay)
+        {
+            detail::checkCic("CicInterpolator", factor, order, differentialDelay, inputBits,
+                             order * std::log2(static_cast<double>(factor) * differentialDelay) - std::log2(std::max(factor, 1)));
+            _integrators.resize(order);
+            _combs.resize(static_cast<size_t>(order) * differentialDelay);
+            reset();
+        }
+
+        [[nodiscard]] int factor() const { return _factor; }
+        [[nodiscard]] int order() const { return _order; }
+        [[nodiscard]] int differentialDelay() const { return _delay; }
+
+        /**
+         * @return The DC gain (R M)^N / R of the integer outputs.
+         */
+        [[nodiscard]] double gain() const { return std::pow(static_cast<double>(_factor) * _delay, _order) / _factor; }
+
+        /**
+         * Clears the combs and integrators, as if the interpolator had only ever seen silence.
+         */
+        void reset()
+        {
+            std::fill(_integrators.begin(), _integrators.end(), 0);
+            std::fill(_combs.begin(), _combs.end(), 0);
+            _combPosition = 0;
+        }
+
+        /**
+         * Filters `count` input samples into exactly count * factor() outputs at full precision,
+         * with a gain of gain(). Never allocates.
+         */
+        void process(const T* input, int count, std::int64_t* output)
+        {
+            run(input, count, [&](int n, std::uint64_t v) { output[n] = static_cast<std::int64_t>(v); });
+        }
+
+        /**
+         * process() with the outputs scaled to unity DC gain.
+         */
+        template<std::floating_point U>
+        void process(const T* input, int count, U* output)
+        {
+            const double scale = 1.0 / gain();
+            run(input, count, [&](int n, std::uint64_t v) { output[n] = static_cast<U>(static_cast<double>(static_cast<std::int64_t>(v)) * scale); });
+        }
+
+    private:
+        template<typename Emit>
+        void run(const T* input, int count, const Emit& emit)
+        {
+            int written = 0;
+            for (int i = 0; i < count; ++i)
+            {
+                std::uint64_t v = static_cast<std::uint64_t>(static_cast<std::int64_t>(input[i]));
+                std::uint64_t* delayed = _combs.data() + _combPosition;
+                for (int s = 0; s < _order; ++s, delayed += _delay)
+                {
+                    const std::uint64_t previous = *delayed;
+                    *delayed = v;
+                    v -= previous;
+                }
+                _combPosition = _combPosition + 1 == _delay ? 0 : _combPosition + 1;
+
+                // The comb output, followed by R - 1 stuffed zeros
+                for (int r = 0; r < _factor; ++r, v = 0)
+                {
+                    std::uint64_t u = v;
+                    for (std::uint64_t& integrator : _integrators)
+                    {
+                        integrator += u;
+                        u = integrator;
+                    }
+                    emit(written++, u);
+                }
+            }
+        }
+
+        int _factor;
+        int _order;
+        int _delay;
+        std::vector<std::uint64_t> _integrators;
+        std::vector<std::uint64_t> _combs;
+        int _combPosition = 0;
+    };
+
+    /**
+     * Compensation FIR for a CIC filter, to run at its low rate: a lowpass whose passband follows
+     * 1 / cicResponse, flattening the droop, and then falls to zero. Designed by frequency
+     * sampling (the inverse DTFT of the ideal response, integrated numerically) and a Kaiser
+     * window, so the taps are symmetric and FirFilter runs them on the folded kernel. DC gain is 1.
+     * @param taps The tap count. Odd counts give an integer group delay. Must be positive.
+     * @param passband The edge of the ideal response in cycles per low-rate sample, in (0, 0.5)
+     *                 and below 1 / differentialDelay, the CIC's first null, where 1 / cicResponse
+     *                 has no finite value. The transition band is centred on it, so the combined
+     *                 response is about -6 dB there; with 31 taps after an order-4 CIC and passband
+     *                 0.2, it is flat to 0.2% up to 0.13.
+     * @param beta The Kaiser window shape (see kaiserWindow).
+     */
+    template<std::floating_point T>
+    std::vector<T> cicCompensationFilter(int order, int factor, int differentialDelay, int taps, double passband, double beta = 6.0)
+    {
+        if (taps < 1 || !(passband > 0.0 && passband < 0.5))
+        {
+            throw std::invalid_argument("dsp::signals::cicCompensationFilter: need a positive tap count and a passband in (0, 0.5)");
+        }
+        if (order < 1 || factor < 1 || differentialDelay < 1)
+        {
+            throw std::invalid_argument("dsp::signals::cicCompensationFilter: order, factor and differential delay must be positive");
+        }
+        if (passband >= 1.0 / differentialDelay)
+        {
+            throw std::invalid_argument("dsp::signals::cicCompensationFilter: passband must end below the first null at 1 / differentialDelay");
+        }
+
+        // h[n] = 2 \int_0^{passband} D(f) cos(2 pi f (n - c)) df with D = 1 / |H_cic|, by the midpoint rule
+        constexpr int STEPS = 4096;
+        const double step = passband / STEPS;
+        const double centre = (taps - 1) / 2.0;
+        std::vector<double> h(taps, 0.0);
+        for (int i = 0; i < STEPS; ++i)
+        {
+            const double f = (i + 0.5) * step;
+            const double weight = 2.0 * step / cicResponse(f, order, factor, differentialDelay);
+            for (int n = 0; n < taps; ++n)
+            {
+                h[n] += weight * std::cos(2.0 * std::numbers::pi * f * (n - centre));
+            }
+        }
+
+        double sum = 0.0;
+        for (int n = 0; n < taps; ++n)
+        {
+            h[n] *= kaiserWindow(taps > 1 ? (n - centre) / centre : 0.0, beta);
+            sum += h[n];
+        }
+        std::vector<T> result(taps);
+        for (int n = 0; n < taps; ++n)
+        {
+            result[n] = static_cast<T>(h[n] / sum);
+        }
+        return result;
+    }
+}
+
+#endif //SIGNAL_PROCESSING_BOOK_CIC_FILTER_H
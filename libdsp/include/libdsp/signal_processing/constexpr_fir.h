@@ -0,0 +1,178 @@
+#ifndef SIGNAL_PROCESSING_BOOK_CONSTEXPR_FIR_H
+#define SIGNAL_PROCESSING_BOOK_CONSTEXPR_FIR_H
+
+#include "libdsp/storage/buffer.h"
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <utility>
+
+namespace dsp::signals
+{
+    /**
+     * Direct-form FIR whose taps are a compile-time constant, e.g.
+     *   ConstexprFir<std::array{0.0, 0.5, -0.2, -0.1}>::convolve(x)
+     *
+     * Each output sample is generated as one straight-line expression over the taps: zero taps are
+     * dropped entirely, taps of +1 / -1 become a plain add / subtract, and every other tap is folded
+     * into the instruction stream as a constant. Nothing is looped over or loaded at runtime except
+     * the input samples, so the compiler is free to vectorize across output samples.
+     *
+     * Meant for fixed filters (anti-aliasing, smoothing) with a handful to a few dozen taps. Every
+     * distinct impulse response instantiates its own kernel, so don't use it for taps that change.
+     * @tparam Taps The impulse response, as a std::array of float or double.
+     */
+    template<auto Taps>
+        requires std::floating_point<typename decltype(Taps)::value_type>
+    class ConstexprFir
+    {
+    public:
+        using T = typename decltype(Taps)::value_type;
+
+        /**
+         * Length of the impulse response (M), including any zero taps.
+         */
+        static constexpr int LENGTH = static_cast<int>(Taps.size());
+
+        /**
+         * Number of taps that survive zero elimination, i.e. the terms summed per output sample.
+         */
+        static constexpr int ACTIVE_TAP_COUNT = [] {
+            int count = 0;
+            for (const T tap : Taps)
+            {
+                count += tap != T(0) ? 1 : 0;
+            }
+            return count;
+        }();
+
+        /**
+         * Same result as convolve1D, with the taps baked into the kernel.
+         * @tparam InputSignalLength The length of the input signal in sample counts (N)
+         * @return The convolved output signal `y`, N + M - 1 samples long
+         */
+        template<int InputSignalLength>
+        static StaticBuffer<T, InputSignalLength + LENGTH - 1> convolve(const StaticBuffer<T, InputSignalLength>& x)
+        {
+            constexpr int outputLength = InputSignalLength + LENGTH - 1;
+            StaticBuffer<T, outputLength> y;
+            const T* input = x._data.data();
+
+            // Steady state: every tap overlaps the input
+            const int steadyBegin = LENGTH - 1;
+            const int steadyEnd = InputSignalLength;
+            for (int i = steadyBegin; i < steadyEnd; ++i)
+            {
+                y._data[i] = respond(input + i);
+            }
+
+            // Head and tail: only some taps overlap the input
+            const auto partial = [input](int i) {
+                T response = 0;
+                for (const int j : ACTIVE_TAPS)
+                {
+                    if (i - j >= 0 && i - j < InputSignalLength)
+                    {
+                        response += Taps[j] * input[i - j];
+                    }
+                }
+                return response;
+            };
+            for (int i = 0; i < steadyBegin && i < outputLength; ++i)
+            {
+                y._data[i] = partial(i);
+            }
+            for (int i = std::max(steadyBegin, steadyEnd); i < outputLength; ++i)
+            {
+                y._data[i] = partial(i);
+            }
+            return y;
+        }
+
+        /**
+         * Only the outputs where the impulse response fully overlaps `x`:
+         *   y[k] = \sum_{j=0}^{M - 1} h[j]x[k + M - 1 - j],  0 <= k <= n - M
+         * @param y Output buffer of n - M + 1 samples. Requires n >= M.
+         */
+        static void convolveValid(const T* x, int n, T* y)
+        {
+            for (int k = 0; k + LENGTH <= n; ++k)
+            {
+                y[k] = respond(x + k + LENGTH - 1);
+            }
+        }
+
+        /**
+         * One output sample, given a pointer to the newest input sample it depends on:
+         *   \sum_{j=0}^{M - 1} h[j]newest[-j]
+         */
+        static T respond(const T* newest)
+        {
+            return respond(newest, std::make_index_sequence<ACTIVE_TAP_COUNT>());
+        }
+
+    private:
+        static constexpr std::array<int, ACTIVE_TAP_COUNT> ACTIVE_TAPS = [] {
+            std::array<int, ACTIVE_TAP_COUNT> indices{};
+            int count = 0;
+            for (int j = 0; j < LENGTH; ++j)
+            {
+                if (Taps[j] != T(0))
+                {
+                    indices[count++] = j;
+                }
+            }
+            return indices;
+        }();
+
+        template<size_t... I>
+        static T respond(const T* newest, std::index_sequence<I...>)
+        {
+            if constexpr (sizeof...(I) == 0)
+            {
+                return T(0);
+            }
+            else
+            {
+                // Left fold in tap order; a negated term is folded into a subtraction
+                return (... + term<ACTIVE_TAPS[I]>(newest));
+            }
+        }
+
+        template<int J>
+        static T term(const T* newest)
+        {
+            constexpr T tap = Taps[J];
+            if constexpr (tap == T(1))
+            {
+                return newest[-J];
+            }
+            else if constexpr (tap == T(-1))
+            {
+                return -newest[-J];
+            }
+            else
+            {
+                return tap * newest[-J];
+            }
+        }
+    };
+
+    /**
+     * convolve1D with a compile-time impulse response; see ConstexprFir.
+     * @tparam Taps The impulse response, as a std::array of float or double.
+     * @tparam T The input signal datatype. Must match the datatype of Taps.
+     * @tparam InputSignalLength The length of the input signal in sample counts (N)
+     */
+    template<auto Taps, typename T, int InputSignalLength>
+    StaticBuffer<T, InputSignalLength + static_cast<int>(Taps.size()) - 1>
+    convolve1D(const StaticBuffer<T, InputSignalLength>& x)
+    {
+        static_assert(std::same_as<T, typename decltype(Taps)::value_type>, "Taps and signal must share a datatype");
+        return ConstexprFir<Taps>::convolve(x);
+    }
+}
+
+#endif //SIGNAL_PROCESSING_BOOK_CONSTEXPR_FIR_H
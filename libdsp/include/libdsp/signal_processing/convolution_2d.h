@@ -0,0 +1,240 @@
+#ifndef SIGNAL_PROCESSING_BOOK_CONVOLUTION_2D_H
+#define SIGNAL_PROCESSING_BOOK_CONVOLUTION_2D_H
+
+#include "libdsp/platform/thread_pool.h"
+#include "libdsp/signal_processing/direct_convolution.h"
+#include "libdsp/signal_processing/signal_processing.h"
+#include "libdsp/storage/buffer2d.h"
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <limits>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace dsp::signals
+{
+    /**
+     * A rank-1 2D kernel h(r, c) = column[r] * row[c].
+     */
+    template<std::floating_point T>
+    struct SeparableKernel
+    {
+        std::vector<T> column;
+        std::vector<T> row;
+    };
+
+    /**
+     * Splits `h` into a column and a row vector if it is rank-1 (separable), e.g. box, Gaussian
+     * and Sobel kernels. Every entry must match column[r] * row[c] to within a small multiple of
+     * the rounding error of the largest entry.
+     * @return The factors, or nothing if `h` is not separable.
+     */
+    template<std::floating_point T>
+    std::optional<SeparableKernel<T>> separate(const Buffer2D<T>& h)
+    {
+        if (h.empty())
+        {
+            return std::nullopt;
+        }
+
+        // Factor around the largest entry, which is the best conditioned pivot
+        int pivotRow = 0;
+        int pivotColumn = 0;
+        T largest = 0;
+        for (int r = 0; r < h.rows(); ++r)
+        {
+            for (int c = 0; c < h.columns(); ++c)
+            {
+                if (std::abs(h(r, c)) > largest)
+                {
+                    largest = std::abs(h(r, c));
+                    pivotRow = r;
+                    pivotColumn = c;
+                }
+            }
+        }
+        if (largest == T(0))
+        {
+            return std::nullopt;
+        }
+
+        SeparableKernel<T> kernel;
+        kernel.column.resize(h.rows());
+        kernel.row.resize(h.columns());
+        for (int r = 0; r < h.rows(); ++r)
+        {
+            kernel.column[r] = h(r, pivotColumn);
+        }
+        for (int c = 0; c < h.columns(); ++c)
+        {
+            kernel.row[c] = h(pivotRow, c) / h(pivotRow, pivotColumn);
+        }
+
+        const T tolerance = largest * std::numeric_limits<T>::epsilon() * 64;
+        for (int r = 0; r < h.rows(); ++r)
+        {
+            for (int c = 0; c < h.columns(); ++c)
+            {
+                if (std::abs(h(r, c) - kernel.column[r] * kernel.row[c]) > tolerance)
+                {
+                    return std::nullopt;
+                }
+            }
+        }
+        return kernel;
+    }
+
+    namespace detail
+    {
+        // Output rows x columns per task. A task's input rows (band + kernel rows - 1) stay in L2
+        // while every kernel row reuses them.
+        constexpr int ROW_BAND = 32;
+        constexpr int COLUMN_TILE = 512;
+
+        /**
+         * Cuts a rows x columns output into ROW_BAND x COLUMN_TILE tiles and calls
+         * fn(firstRow, endRow, firstColumn, width) for each of them on `pool`.
+         */
+        template<typename Fn>
+        void forEachTile(int rows, int columns, platform::ThreadPool& pool, const Fn& fn)
+        {
+            const int bands = (rows + ROW_BAND - 1) / ROW_BAND;
+            const int tiles = (columns + COLUMN_TILE - 1) / COLUMN_TILE;
+            pool.parallelFor(bands * tiles, 1, [&](int begin, int end) {
+                for (int task = begin; task < end; ++task)
+                {
+                    const int i0 = (task / tiles) * ROW_BAND;
+                    const int c0 = (task % tiles) * COLUMN_TILE;
+                    fn(i0, std::min(rows, i0 + ROW_BAND), c0, std::min(COLUMN_TILE, columns - c0));
+                }
+            });
+        }
+    }
+
+    /**
+     * 2D convolution with a separable kernel h(r, c) = column[r] * row[c], as two 1D passes:
+     * the input rows are convolved with `row`, then those intermediate rows are combined down each
+     * column with `column`. That is K_r + K_c multiply-adds per pixel instead of K_r * K_c.
+     *
+     * Runs tile by tile across `pool`; each tile filters just the input rows it needs into a
+     * small scratch block, so the intermediate image never exists in full. Neighbouring tiles
+     * redo K_r - 1 rows of the horizontal pass each, a small price for staying in cache.
+     */
+    template<std::floating_point T>
+    Buffer2D<T> convolve2DSeparable(const Buffer2D<T>& x, const SeparableKernel<T>& kernel,
+                                    ConvolutionRegion region = ConvolutionRegion::Full,
+                                    platform::ThreadPool& pool = platform::ThreadPool::shared())
+    {
+        const int kernelRows = static_cast<int>(kernel.column.size());
+        const int kernelColumns = static_cast<int>(kernel.row.size());
+        const auto [rowOffset, outputRows] = regionBounds(region, x.rows(), kernelRows);
+        const auto [columnOffset, outputColumns] = regionBounds(region, x.columns(), kernelColumns);
+        Buffer2D<T> y(outputRows, outputColumns);
+        if (y.empty() || x.empty())
+        {
+            return y;
+        }
+
+        detail::forEachTile(outputRows, outputColumns, pool, [&](int i0, int i1, int c0, int width) {
+            // Input rows reachable from full-output rows [rowOffset + i0, rowOffset + i1)
+            const int firstInput = std::max(0, rowOffset + i0 - kernelRows + 1);
+            const int endInput = std::min(x.rows(), rowOffset + i1);
+            const int segment = width + kernelColumns - 1;
+            std::vector<T> padded(segment);
+            std::vector<T> horizontal(static_cast<size_t>(std::max(0, endInput - firstInput)) * width);
+
+            for (int r = firstInput; r < endInput; ++r)
+            {
+                detail::copyPadded(x.row(r), columnOffset + c0 - kernelColumns + 1, segment, padded.data());
+                convolveValid(padded.data(), segment, kernel.row.data(), kernelColumns,
+                              horizontal.data() + static_cast<size_t>(r - firstInput) * width);
+            }
+
+            // Output row i is \sum_k column[k] * horizontal[i - k], a contiguous axpy per tap
+            for (int i = i0; i < i1; ++i)
+            {
+                const int fullRow = rowOffset + i;
+                T* out = y.row(i).data() + c0;
+                const int kBegin = std::max(0, fullRow - x.rows() + 1);
+                const int kEnd = std::min(kernelRows, fullRow + 1);
+                for (int k = kBegin; k < kEnd; ++k)
+                {
+                    const T tap = kernel.column[k];
+                    const T* in = horizontal.data() + static_cast<size_t>(fullRow - k - firstInput) * width;
+                    for (int c = 0; c < width; ++c)
+                    {
+                        out[c] += tap * in[c];
+                    }
+                }
+            }
+        });
+        return y;
+    }
+
+    /**
+     * 2D convolution of an image-shaped buffer:
+     *   y(i, j) = \sum_{a, b} h(a, b) x(i - a, j - b)
+     *
+     * Rank-1 kernels are detected (see separate()) and run as two 1D passes. Anything else is
+     * computed one output row at a time as a sum of 1D convolutions of the overlapping input rows
+     * with the matching kernel rows, on the vectorized convolveValid kernel. The output is cut
+     * into tiles of rows and columns; each tile copies the zero-padded input it needs into a
+     * scratch block that stays in cache while every kernel row reuses it, and the tiles are
+     * spread across `pool`.
+     * @param region Full (every overlapping output), Same (same size as x) or Valid.
+     */
+    template<std::floating_point T>
+    Buffer2D<T> convolve2D(const Buffer2D<T>& x, const Buffer2D<T>& h,
+                           ConvolutionRegion region = ConvolutionRegion::Full,
+                           platform::ThreadPool& pool = platform::ThreadPool::shared())
+    {
+        if (const auto kernel = separate(h))
+        {
+            return convolve2DSeparable(x, *kernel, region, pool);
+        }
+
+        const auto [rowOffset, outputRows] = regionBounds(region, x.rows(), h.rows());
+        const auto [columnOffset, outputColumns] = regionBounds(region, x.columns(), h.columns());
+        Buffer2D<T> y(outputRows, outputColumns);
+        if (y.empty() || x.empty() || h.empty())
+        {
+            return y;
+        }
+
+        detail::forEachTile(outputRows, outputColumns, pool, [&](int i0, int i1, int c0, int width) {
+            const int firstInput = std::max(0, rowOffset + i0 - h.rows() + 1);
+            const int endInput = std::min(x.rows(), rowOffset + i1);
+            const int segment = width + h.columns() - 1;
+            std::vector<T> tile(static_cast<size_t>(std::max(0, endInput - firstInput)) * segment);
+            std::vector<T> scratch(width);
+            for (int r = firstInput; r < endInput; ++r)
+            {
+                detail::copyPadded(x.row(r), columnOffset + c0 - h.columns() + 1, segment,
+                                   tile.data() + static_cast<size_t>(r - firstInput) * segment);
+            }
+
+            for (int i = i0; i < i1; ++i)
+            {
+                const int fullRow = rowOffset + i;
+                T* out = y.row(i).data() + c0;
+                const int aBegin = std::max(0, fullRow - x.rows() + 1);
+                const int aEnd = std::min(h.rows(), fullRow + 1);
+                for (int a = aBegin; a < aEnd; ++a)
+                {
+                    convolveValid(tile.data() + static_cast<size_t>(fullRow - a - firstInput) * segment, segment,
+                                  h.row(a).data(), h.columns(), scratch.data());
+                    for (int c = 0; c < width; ++c)
+                    {
+                        out[c] += scratch[c];
+                    }
+                }
+            }
+        });
+        return y;
+    }
+}
+
+#endif //SIGNAL_PROCESSING_BOOK_CONVOLUTION_2D_H
@@ -0,0 +1,148 @@
+#ifndef SIGNAL_PROCESSING_BOOK_CONVOLUTION_PLANNER_H
+#define SIGNAL_PROCESSING_BOOK_CONVOLUTION_PLANNER_H
+
+#include "libdsp/fft/plan_cache.h"
+#include "libdsp/storage/buffer.h"
+
+#include <array>
+#include <concepts>
+#include <shared_mutex>
+#include <span>
+#include <string>
+
+namespace dsp::signals
+{
+    /**
+     * The ways libdsp can compute a whole-signal linear convolution.
+     *  - Direct: the output-side loop of convolve1D
+     *  - SimdDirect: the same loop on the vectorized kernels (convolveDirect)
+     *  - Fft: overlap-save block convolution (FftConvolver)
+     *  - Partitioned: uniformly partitioned convolution (PartitionedConvolver), run over the whole signal
+     *  - Sparse: only the non-zero taps of the kernel, one at a time (SparseImpulseResponse)
+     */
+    enum class ConvolutionStrategy
+    {
+        Direct,
+        SimdDirect,
+        Fft,
+        Partitioned,
+        Sparse
+    };
+
+    /**
+     * @return A short lowercase name for `strategy` ("direct", "simd", "fft", "partitioned" or "sparse").
+     */
+    const char* strategyName(ConvolutionStrategy strategy);
+
+    /**
+     * Picks the fastest convolution strategy for a signal length N and kernel length M.
+     *
+     * Decisions come from a table of (log2 N, log2 M) cells per precision. Out of the box the table
+     * holds a conservative guess (vectorized direct form up to a few hundred taps, FFT beyond).
+     * calibrate() times every strategy on this machine and fills the table with the winners, and
+     * the result can be saved and reloaded, much like FFT wisdom. The table never holds Sparse,
+     * which depends on the kernel's values rather than its length; convolve() checks for that first.
+     *
+     * On first use, the process-wide instance loads the calibration file named by the
+     * DSP_CONVOLUTION_CALIBRATION environment variable, if it is set.
+     */
+    class ConvolutionPlanner
+    {
+    public:
+        static ConvolutionPlanner& instance();
+
+        ConvolutionPlanner();
+        ConvolutionPlanner(const ConvolutionPlanner&) = delete;
+        ConvolutionPlanner& operator=(const ConvolutionPlanner&) = delete;
+
+        /**
+         * @return The strategy to use for a signal of n samples and a kernel of m samples.
+         *         The order of n and m doesn't matter, since convolution commutes.
+         */
+        [[nodiscard]] ConvolutionStrategy choose(int n, int m, fft::Precision precision) const;
+
+        /**
+         * Times every strategy across the table's cells on this machine and keeps the fastest.
+         * Takes a few seconds. Strategies that are already far behind at a shorter kernel length
+         * are not timed again for longer ones.
+         */
+        void calibrate();
+
+        /**
+         * @return True if the table came from calibrate() or loadCalibration() rather than the defaults.
+         */
+        [[nodiscard]] bool isCalibrated() const;
+
+        /**
+         * Writes the decision table to `path`.
+         * @return False if the file could not be written.
+         */
+        bool saveCalibration(const std::string& path) const;
+
+        /**
+         * Replaces the decision table with one written by saveCalibration(). The current table is
+         * kept if the file is missing or malformed.
+         * @return False if the file could not be read or isn't a valid calibration file.
+         */
+        bool loadCalibration(const std::string& path);
+
+        /**
+         * Goes back to the built-in default table.
+         */
+        void reset();
+
+    private:
+        // Signal lengths 2^MIN_LOG2_N ... 2^MAX_LOG2_N in steps of 2, kernel lengths 2^0 ... 2^MAX_LOG2_M.
+        // Sizes outside the grid use the nearest cell.
+        static constexpr int MIN_LOG2_N = 6;
+        static constexpr int MAX_LOG2_N = 16;
+        static constexpr int N_CELLS = (MAX_LOG2_N - MIN_LOG2_N) / 2 + 1;
+        static constexpr int MAX_LOG2_M = 16;
+        static constexpr int M_CELLS = MAX_LOG2_M + 1;
+
+        using Table = std::array<std::array<std::array<ConvolutionStrategy, M_CELLS>, N_CELLS>, 2>;
+
+        static Table defaultTable();
+
+        template<std::floating_point T>
+        void calibratePrecision(Table& table) const;
+
+        mutable std::shared_mutex _mutex;
+        Table _table;
+        bool _calibrated = false;
+    };
+
+    /**
+     * Linear convolution of `x` (N samples) with `h` (M samples) into `y` (N + M - 1 samples,
+     * none if `x` or `h` is empty).
+     * Uses the Sparse strategy if `h` has few enough non-zero taps (see
+     * SparseImpulseResponse::beatsDense), and otherwise the one ConvolutionPlanner::instance()
+     * picks for N and M.
+     */
+    void convolve(std::span<const float> x, std::span<const float> h, std::span<float> y);
+    void convolve(std::span<const double> x, std::span<const double> h, std::span<double> y);
+
+    /**
+     * convolve() with an explicit strategy, e.g. to compare strategies or to skip the planner.
+     */
+    void convolve(ConvolutionStrategy strategy, std::span<const float> x, std::span<const float> h, std::span<float> y);
+    void convolve(ConvolutionStrategy strategy, std::span<const double> x, std::span<const double> h, std::span<double> y);
+
+    /**
+     * convolve1D on libdsp buffers, with the algorithm picked by ConvolutionPlanner.
+     * @tparam T The sample datatype. Must be float or double.
+     * @tparam InputSignalLength The length of the input signal in sample counts (N)
+     * @tparam ImpulseResponseLength The length of the impulse response in sample counts (M)
+     * @return The convolved output signal `y`, N + M - 1 samples long
+     */
+    template<std::floating_point T, int InputSignalLength, int ImpulseResponseLength>
+    StaticBuffer<T, ImpulseResponseLength + InputSignalLength - 1>
+    convolve(const StaticBuffer<T, InputSignalLength>& x, const StaticBuffer<T, ImpulseResponseLength>& h)
+    {
+        StaticBuffer<T, ImpulseResponseLength + InputSignalLength - 1> y;
+        convolve(std::span<const T>(x._data), std::span<const T>(h._data), std::span<T>(y._data));
+        return y;
+    }
+}
+
+#endif //SIGNAL_PROCESSING_BOOK_CONVOLUTION_PLANNER_H
@@ -0,0 +1,326 @@
+#ifndef SIGNAL_PROCESSING_BOOK_CORRELATION_H
+#define SIGNAL_PROCESSING_BOOK_CORRELATION_H
+
+#include "libdsp/fft/plan_cache.h"
+#include "libdsp/signal_processing/direct_convolution.h"
+#include "libdsp/signal_processing/signal_processing.h"
+#include "libdsp/storage/buffer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <concepts>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace dsp::signals
+{
+    /**
+     * How correlation outputs are scaled, for lag k between x (N samples) and y (M samples):
+     *  - None: the raw sum r[k] = \sum_n x[n + k]y[n]
+     *  - Biased: r[k] / N. Shrinks towards large lags, but has lower variance
+     *  - Unbiased: r[k] / (number of overlapping samples at lag k)
+     *  - Coefficient: r[k] / sqrt(\sum x^2 \sum y^2), over the energies of the whole signals rather
+     *    than of the overlap at lag k. |r| <= 1, and 1 is only reached when the overlapping samples
+     *    hold all the energy of both signals and are proportional
+     */
+    enum class CorrelationScaling
+    {
+        None,
+        Biased,
+        Unbiased,
+        Coefficient
+    };
+
+    namespace detail
+    {
+        // Samples of y per block in correlateLags' direct path
+        constexpr int CORRELATION_BLOCK = 4096;
+
+        // Smallest transform correlateLags cuts long signals into
+        constexpr int MIN_BLOCK_TRANSFORM = 16384;
+
+        // Rough cost of one point of a point * log2(size) FFT pass, in vectorized multiply-adds
+        constexpr double FFT_COST_PER_POINT = 8.0;
+
+        /**
+         * Number of n with 0 <= n < m and 0 <= n + lag < n_x.
+         */
+        inline int overlapAtLag(int lag, int xLength, int yLength)
+        {
+            return std::max(0, std::min(yLength, xLength - lag) - std::max(0, -lag));
+        }
+
+        template<std::floating_point T>
+        double energy(std::span<const T> x)
+        {
+            double sum = 0.0;
+            for (const T sample : x)
+            {
+                sum += static_cast<double>(sample) * sample;
+            }
+            return sum;
+        }
+
+        template<std::floating_point T>
+        void scale(std::span<T> r, int firstLag, int xLength, int yLength, double coefficientNorm, CorrelationScaling scaling)
+        {
+            for (size_t i = 0; i < r.size(); ++i)
+            {
+                const int lag = firstLag + static_cast<int>(i);
+                switch (scaling)
+                {
+                    case CorrelationScaling::Biased:
+                        r[i] = static_cast<T>(r[i] / static_cast<double>(xLength));
+                        break;
+                    case CorrelationScaling::Unbiased:
+                    {
+                        const int overlap = overlapAtLag(lag, xLength, yLength);
+                        r[i] = overlap > 0 ? static_cast<T>(r[i] / static_cast<double>(overlap)) : T(0);
+                        break;
+                    }
+                    case CorrelationScaling::Coefficient:
+                        r[i] = coefficientNorm > 0.0 ? static_cast<T>(r[i] / coefficientNorm) : T(0);
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+
+        /**
+         * Circular cross-correlation c[k] = \sum_n x[n + k]y[n] (indices mod L) with a real FFT of
+         * size L. When L >= N + M - 1 there is no wrap-around: lag k lives at c[(k + L) % L].
+         * Passing the same span twice computes an autocorrelation with one forward transform.
+         */
+        template<std::floating_point T>
+        std::vector<T> circularCorrelation(std::span<const T> x, std::span<const T> y, int size)
+        {
+            auto& cache = fft::PlanCache::instance();
+            const auto forward = cache.realPlan<T>(size, fft::Direction::Forward);
+            const auto inverse = cache.realPlan<T>(size, fft::Direction::Inverse);
+
+            std::vector<T> padded(size, T(0));
+            std::copy(x.begin(), x.end(), padded.begin());
+            std::vector<std::complex<T>> spectrumX(forward->spectrumSize());
+            forward->execute(std::span<const T>(padded), spectrumX);
+
+            const bool autocorrelation = x.data() == y.data() && x.size() == y.size();
+            std::vector<std::complex<T>> spectrumY;
+            if (!autocorrelation)
+            {
+                std::fill(padded.begin(), padded.end(), T(0));
+                std::copy(y.begin(), y.end(), padded.begin());
+                spectrumY.resize(forward->spectrumSize());
+                forward->execute(std::span<const T>(padded), spectrumY);
+            }
+
+            // X * conj(Y)
+            for (size_t k = 0; k < spectrumX.size(); ++k)
+            {
+                spectrumX[k] = fft::detail::multiplyConjugate(spectrumX[k], autocorrelation ? spectrumX[k] : spectrumY[k]);
+            }
+            inverse->execute(std::span<const std::complex<T>>(spectrumX), padded);
+            return padded;
+        }
+
+        /**
+         * Cross-correlation at lags minLag ... minLag + lagCount - 1 with transforms of `size`
+         * points (> lagCount), however long x and y are. y is cut into blocks of
+         * size - lagCount + 1 samples, each block is correlated with the stretch of x its lags
+         * reach, and the products are summed in the frequency domain so one inverse transform
+         * finishes the job. The transforms stay in cache, unlike one transform of N + M points.
+         */
+        template<std::floating_point T>
+        std::vector<T> blockCorrelation(std::span<const T> x, std::span<const T> y, int minLag, int lagCount, int size)
+        {
+            auto& cache = fft::PlanCache::instance();
+            const auto forward = cache.realPlan<T>(size, fft::Direction::Forward);
+            const auto inverse = cache.realPlan<T>(size, fft::Direction::Inverse);
+            const int n = static_cast<int>(x.size());
+            const int m = static_cast<int>(y.size());
+            const int block = size - lagCount + 1;
+
+            std::vector<T> padded(size);
+            std::vector<std::complex<T>> segmentSpectrum(forward->spectrumSize());
+            std::vector<std::complex<T>> blockSpectrum(forward->spectrumSize());
+            std::vector<std::complex<T>> sum(forward->spectrumSize());
+            for (int start = 0; start < m; start += block)
+            {
+                // x[start + minLag + t] for t in [0, block + lagCount - 1), zero outside x
+                const int first = start + minLag;
+                std::fill(padded.begin(), padded.end(), T(0));
+                for (int t = std::max(0, -first); t < size && first + t < n; ++t)
+                {
+                    padded[t] = x[first + t];
+                }
+                forward->execute(std::span<const T>(padded), segmentSpectrum);
+
+                std::fill(padded.begin(), padded.end(), T(0));
+                const int length = std::min(block, m - start);
+                std::copy_n(y.begin() + start, length, padded.begin());
+                forward->execute(std::span<const T>(padded), blockSpectrum);
+
+                for (size_t k = 0; k < sum.size(); ++k)
+                {
+                    sum[k] += fft::detail::multiplyConjugate(segmentSpectrum[k], blockSpectrum[k]);
+                }
+            }
+            inverse->execute(std::span<const std::complex<T>>(sum), padded);
+            padded.resize(lagCount);
+            return padded;
+        }
+    }
+
+    /**
+     * Cross-correlation of x (N samples) against y (M samples), computed with real FFTs in
+     * O((N + M) log(N + M)):
+     *   r[k] = \sum_n x[n + k]y[n],  -(M - 1) <= k <= N - 1
+     * This equals convolving x with y reversed, so output i of the Full region is lag i - (M - 1),
+     * and the Same / Valid regions are the same slices of it as for convolution.
+     * A peak at lag k means y best matches x starting at x[k], i.e. x lags y by k samples.
+     */
+    template<std::floating_point T>
+    std::vector<T> correlate(std::span<const T> x, std::span<const T> y,
+                             ConvolutionRegion region = ConvolutionRegion::Full,
+                             CorrelationScaling scaling = CorrelationScaling::None)
+    {
+        const int n = static_cast<int>(x.size());
+        const int m = static_cast<int>(y.size());
+        if (n == 0 || m == 0)
+        {
+            return {};
+        }
+
+        const auto [offset, length] = regionBounds(region, n, m);
+        const int size = std::max(2, fft::nextPowerOfTwo(n + m - 1));
+        const std::vector<T> circular = detail::circularCorrelation(x, y, size);
+
+        std::vector<T> r(length);
+        const int firstLag = offset - (m - 1);
+        for (int i = 0; i < length; ++i)
+        {
+            r[i] = circular[(firstLag + i + size) % size];
+        }
+        detail::scale(std::span<T>(r), firstLag, n, m, std::sqrt(detail::energy(x) * detail::energy(y)), scaling);
+        return r;
+    }
+
+    /**
+     * Cross-correlation at only the lags minLag ... maxLag (inclusive); output i is lag minLag + i.
+     * The cost grows with the number of lags rather than with N + M:
+     *  - A few lags are vectorized dot products over the overlapping samples, run block by block
+     *  - Wider ranges correlate y block by block in the frequency domain, with transforms of
+     *    about twice the number of lags instead of one transform of the whole signals
+     */
+    template<std::floating_point T>
+    std::vector<T> correlateLags(std::span<const T> x, std::span<const T> y, int minLag, int maxLag,
+                                 CorrelationScaling scaling = CorrelationScaling::None)
+    {
+        if (maxLag < minLag)
+        {
+            throw std::invalid_argument("dsp::signals::correlateLags: maxLag must not be less than minLag");
+        }
+        const int n = static_cast<int>(x.size());
+        const int m = static_cast<int>(y.size());
+        const int lagCount = maxLag - minLag + 1;
+        std::vector<T> r(lagCount, T(0));
+        if (n == 0 || m == 0)
+        {
+            return r;
+        }
+
+        // Direct costs ~lagCount * M multiply-adds. The FFT path costs two transforms per block of
+        // y plus one inverse, each costing far more per point than a vectorized multiply-add
+        const int fullSize = std::max(2, fft::nextPowerOfTwo(n + m - 1));
+        const int size = std::min(fullSize, std::max(detail::MIN_BLOCK_TRANSFORM, fft::nextPowerOfTwo(2 * lagCount)));
+        const int blocks = size == fullSize ? 1 : (m + size - lagCount) / (size - lagCount + 1);
+        const double directCost = static_cast<double>(lagCount) * std::min(n, m);
+        const double fftCost = detail::FFT_COST_PER_POINT * (2.0 * blocks + 1.0) * size * std::log2(size);
+        if (directCost <= fftCost)
+        {
+            // Walk y in blocks and run every lag over a block before moving on, so the block and
+            // the stretch of x it meets stay in cache instead of streaming both from memory per lag
+            for (int start = 0; start < m; start += detail::CORRELATION_BLOCK)
+            {
+                const int end = std::min(m, start + detail::CORRELATION_BLOCK);
+                for (int i = 0; i < lagCount; ++i)
+                {
+                    const int lag = minLag + i;
+                    const int first = std::max(start, -lag);
+                    const int last = std::min(end, n - lag);
+                    if (first < last)
+                    {
+                        r[i] += dotProduct(x.data() + first + lag, y.data() + first, last - first);
+                    }
+                }
+            }
+        }
+        else if (size == fullSize)
+        {
+            const std::vector<T> circular = detail::circularCorrelation(x, y, size);
+            for (int i = 0; i < lagCount; ++i)
+            {
+                const int lag = minLag + i;
+                if (lag > -m && lag < n)
+                {
+                    r[i] = circular[(lag + size) % size];
+                }
+            }
+        }
+        else
+        {
+            r = detail::blockCorrelation(x, y, minLag, lagCount, size);
+        }
+
+        detail::scale(std::span<T>(r), minLag, n, m, std::sqrt(detail::energy(x) * detail::energy(y)), scaling);
+        return r;
+    }
+
+    /**
+     * One-sided autocorrelation r[k] = \sum_n x[n + k]x[n] for lags 0 ... maxLag (r is symmetric,
+     * so negative lags add nothing). Long lag ranges use a single forward FFT of N + maxLag
+     * points; short ones go through correlateLags().
+     * With Coefficient scaling r[0] is 1.
+     * @param maxLag The largest lag to return; -1 (the default) means N - 1.
+     */
+    template<std::floating_point T>
+    std::vector<T> autocorrelate(std::span<const T> x, int maxLag = -1,
+                                 CorrelationScaling scaling = CorrelationScaling::None)
+    {
+        const int n = static_cast<int>(x.size());
+        if (n == 0)
+        {
+            return {};
+        }
+        maxLag = maxLag < 0 ? n - 1 : std::min(maxLag, n - 1);
+        if (4 * (maxLag + 1) < n)
+        {
+            return correlateLags(x, x, 0, maxLag, scaling);
+        }
+
+        // Lags up to maxLag can't wrap around into each other once size >= N + maxLag
+        const int size = std::max(2, fft::nextPowerOfTwo(n + maxLag));
+        const std::vector<T> circular = detail::circularCorrelation(x, x, size);
+        std::vector<T> r(circular.begin(), circular.begin() + maxLag + 1);
+        detail::scale(std::span<T>(r), 0, n, n, detail::energy(x), scaling);
+        return r;
+    }
+
+    /**
+     * Full cross-correlation of two libdsp buffers; output i is lag i - (M - 1).
+     * @return The N + M - 1 sample correlation
+     */
+    template<std::floating_point T, int N, int M>
+    StaticBuffer<T, N + M - 1> correlate1D(const StaticBuffer<T, N>& x, const StaticBuffer<T, M>& y,
+                                           CorrelationScaling scaling = CorrelationScaling::None)
+    {
+        const std::vector<T> r = correlate(std::span<const T>(x._data), std::span<const T>(y._data), ConvolutionRegion::Full, scaling);
+        StaticBuffer<T, N + M - 1> result;
+        std::copy(r.begin(), r.end(), result._data.begin());
+        return result;
+    }
+}
+
+#endif //SIGNAL_PROCESSING_BOOK_CORRELATION_H
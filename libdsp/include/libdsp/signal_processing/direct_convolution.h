@@ -0,0 +1,130 @@
+#ifndef SIGNAL_PROCESSING_BOOK_DIRECT_CONVOLUTION_H
+#define SIGNAL_PROCESSING_BOOK_DIRECT_CONVOLUTION_H
+
+#include "libdsp/platform/cpu_features.h"
+#include "libdsp/storage/buffer.h"
+
+#include <concepts>
+
+namespace dsp::signals
+{
+    /**
+     * Direct-form (output-side) convolution of `x` (n samples) with `h` (m samples):
+     *   y[i] = \sum_{j=0}^{m - 1} h[j]x[i - j],  0 <= i < n + m - 1
+     *
+     * Same result as convolve1D, but the loop is split into a head, steady-state and tail region
+     * so that the steady state has no bounds checks and runs on hand-vectorized SSE2 / AVX2 /
+     * AVX-512 / NEON kernels picked at runtime for the host CPU. The head and tail (the first and
+     * last m - 1 outputs, where h only partially overlaps x) run through the same kernel on a
+     * small zero-padded copy of the edge of `x`.
+     *
+     * Best for short impulse responses; for long ones see FftConvolver.
+     * @param y Output buffer of n + m - 1 samples. Must not overlap `x` or `h`.
+     */
+    void convolveDirect(const float* x, int n, const float* h, int m, float* y);
+    void convolveDirect(const double* x, int n, const double* h, int m, double* y);
+
+    /**
+     * Only the outputs of convolveDirect where `h` fully overlaps `x`:
+     *   y[k] = \sum_{j=0}^{m - 1} h[j]x[k + m - 1 - j],  0 <= k <= n - m
+     * This is the steady-state kernel on its own, for callers (e.g. streaming filters) that keep
+     * m - 1 samples of history in front of their input.
+     * @param y Output buffer of n - m + 1 samples. Must not overlap `x` or `h`. Requires n >= m.
+     */
+    void convolveValid(const float* x, int n, const float* h, int m, float* y);
+    void convolveValid(const double* x, int n, const double* h, int m, double* y);
+
+    /**
+     * Inner product \sum_{i=0}^{count - 1} a[i]b[i] on the same vectorized kernels. The building
+     * block for filters that only compute some of their outputs (decimators, resamplers): with the
+     * taps stored in reverse, one output is a dot product with a contiguous run of input samples.
+     */
+    float dotProduct(const float* a, const float* b, int count);
+    double dotProduct(const double* a, const double* b, int count);
+
+    /**
+     * Symmetry of an impulse response about its centre, as the folded kernels use it.
+     */
+    enum class FirSymmetry
+    {
+        None,
+        Symmetric,    // h[m - 1 - j] == h[j]: linear phase, e.g. every windowed-sinc lowpass
+        Antisymmetric // h[m - 1 - j] == -h[j]: differentiators, Hilbert transformers
+    };
+
+    /**
+     * @return The symmetry of h[0, m), compared exactly. Window and sinc designs come out exactly
+     *         symmetric, since negating their argument only flips a sign bit.
+     */
+    template<std::floating_point T>
+    FirSymmetry firSymmetry(const T* h, int m)
+    {
+        bool symmetric = true;
+        bool antisymmetric = true;
+        for (int j = 0; j < m / 2 + m % 2; ++j)
+        {
+            symmetric = symmetric && h[m - 1 - j] == h[j];
+            antisymmetric = antisymmetric && h[m - 1 - j] == -h[j];
+        }
+        return symmetric ? FirSymmetry::Symmetric : (antisymmetric ? FirSymmetry::Antisymmetric : FirSymmetry::None);
+    }
+
+    /**
+     * convolveValid for an impulse response with the given symmetry. The two samples that meet
+     * taps j and m - 1 - j are added (or subtracted) first and multiplied by h[j] once, so it takes
+     * half the multiplies; only h[0, (m + 1) / 2) is read. With FirSymmetry::None this is
+     * convolveValid.
+     */
+    void convolveValidFolded(const float* x, int n, const float* h, int m, FirSymmetry symmetry, float* y);
+    void convolveValidFolded(const double* x, int n, const double* h, int m, FirSymmetry symmetry, double* y);
+
+    /**
+     * convolveDirect for an impulse response with the given symmetry, folded as in
+     * convolveValidFolded. Falls back to convolveDirect when `h` is longer than `x`.
+     */
+    void convolveDirectFolded(const float* x, int n, const float* h, int m, FirSymmetry symmetry, float* y);
+    void convolveDirectFolded(const double* x, int n, const double* h, int m, FirSymmetry symmetry, double* y);
+
+    /**
+     * Outputs [first, first + count) of the full convolution of `x` (n samples) with a sparse
+     * impulse response of `taps` (offset, gain) pairs, h[offsets[t]] = gains[t]:
+     *   y[i - first] = \sum_t gains[t] x[i - offsets[t]]
+     * Each tap costs one vectorized multiply-add per output, however far apart the taps are.
+     * See SparseImpulseResponse for the convenient interface.
+     * @param offsets Non-negative and strictly ascending.
+     * @param y Output buffer of `count` samples. Must not overlap the inputs.
+     */
+    void convolveSparse(const float* x, int n, const int* offsets, const float* gains, int taps, float* y, int first, int count);
+    void convolveSparse(const double* x, int n, const int* offsets, const double* gains, int taps, double* y, int first, int count);
+
+    /**
+     * @return The instruction set the direct-form kernels currently dispatch to. Defaults to the
+     *         widest one the host supports.
+     */
+    platform::SimdLevel activeSimdLevel();
+
+    /**
+     * Forces the direct-form kernels onto a given instruction set, e.g. to benchmark or test the
+     * narrower paths on a wide machine.
+     * @return False (and leaves the current level alone) if the host or this build cannot run `level`.
+     */
+    bool setSimdLevel(platform::SimdLevel level);
+
+    /**
+     * convolve1D on libdsp buffers, using the vectorized direct-form kernels.
+     * @tparam T The sample datatype. Must be float or double.
+     * @tparam InputSignalLength The length of the input signal in sample counts (N)
+     * @tparam ImpulseResponseLength The length of the impulse response in sample counts (M)
+     * @return The convolved output signal `y`, N + M - 1 samples long
+     */
+    template<std::floating_point T, int InputSignalLength, int ImpulseResponseLength>
+    StaticBuffer<T, ImpulseResponseLength + InputSignalLength - 1>
+    convolve1DSimd(const StaticBuffer<T, InputSignalLength>& x, const StaticBuffer<T, ImpulseResponseLength>& h)
+    {
+        StaticBuffer<T, ImpulseResponseLength + InputSignalLength - 1> y;
+        convolveDirect(x._data.data(), InputSignalLength, h._data.data(), ImpulseResponseLength, y._data.data());
+        return y;
+    }
+}
+
+#endif //SIGNAL_PROCESSING_BOOK_DIRECT_CONVOLUTION_H
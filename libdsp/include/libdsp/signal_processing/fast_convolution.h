@@ -0,0 +1,198 @@
+#ifndef SIGNAL_PROCESSING_BOOK_FAST_CONVOLUTION_H
+#define SIGNAL_PROCESSING_BOOK_FAST_CONVOLUTION_H
+
+#include "libdsp/fft/plan_cache.h"
+#include "libdsp/storage/buffer.h"
+
+#include <algorithm>
+#include <complex>
+#include <concepts>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace dsp::signals
+{
+    /**
+     * How FftConvolver splits a long input into FFT-sized blocks.
+     *  - OverlapAdd: zero-pads each input block, transforms it and adds the overlapping
+     *    tails of neighbouring output blocks together.
+     *  - OverlapSave: transforms overlapping input blocks and discards the M - 1 circularly
+     *    wrapped output samples of each block, so no output accumulation is needed.
+     */
+    enum class BlockMode
+    {
+        OverlapAdd,
+        OverlapSave
+    };
+
+    /**
+     * FFT-based block convolution engine. Produces the same output as convolve1D in
+     * O(N log M) instead of O(N * M), which pays off once the impulse response is more
+     * than a few dozen taps long.
+     *
+     * The impulse response spectrum is computed once at construction, so an engine can be
+     * reused to filter any number of input signals with the same impulse response. The FFT
+     * plans come from the process-wide fft::PlanCache.
+     * @tparam T The sample datatype. Must be float or double.
+     */
+    template<std::floating_point T>
+    class FftConvolver
+    {
+    public:
+        /**
+         * @param h The impulse response (M samples).
+         * @param mode The block convolution algorithm to use.
+         * @param fftSize The FFT block size. Must be larger than M and even, with no prime factors
+         *                other than 2, 3 and 5 in fftSize / 2 (see fft::RealPlan), e.g. 1024 or 1536.
+         *                Defaults to 4 * M rounded up to the next power of two, which keeps the
+         *                fraction of each block spent on the M - 1 overlap samples small.
+         */
+        explicit FftConvolver(std::span<const T> h, BlockMode mode = BlockMode::OverlapSave, int fftSize = 0)
+            : _impulseResponseLength(static_cast<int>(h.size())),
+              _fftSize(validatedFftSize(fftSize, static_cast<int>(h.size()))),
+              _mode(mode),
+              _forward(fft::PlanCache::instance().realPlan<T>(_fftSize, fft::Direction::Forward)),
+              _inverse(fft::PlanCache::instance().realPlan<T>(_fftSize, fft::Direction::Inverse))
+        {
+            std::vector<T> paddedKernel(_fftSize, T(0));
+            std::copy(h.begin(), h.end(), paddedKernel.begin());
+            _kernelSpectrum.resize(_forward->spectrumSize());
+            _forward->execute(std::span<const T>(paddedKernel), _kernelSpectrum);
+        }
+
+        [[nodiscard]] int impulseResponseLength() const { return _impulseResponseLength; }
+        [[nodiscard]] int fftSize() const { return _fftSize; }
+        [[nodiscard]] BlockMode mode() const { return _mode; }
+
+        /**
+         * Number of new output samples produced per FFT block (L - M + 1).
+         */
+        [[nodiscard]] int blockSize() const { return _fftSize - _impulseResponseLength + 1; }
+
+        /**
+         * Convolves `x` against the impulse response.
+         * @param x The input signal (N samples)
+         * @param y The output signal. Must hold N + M - 1 samples.
+         */
+        void convolve(std::span<const T> x, std::span<T> y) const
+        {
+            const int inputLength = static_cast<int>(x.size());
+            const int outputLength = inputLength + _impulseResponseLength - 1;
+            if (static_cast<int>(y.size()) != outputLength)
+            {
+                throw std::invalid_argument("dsp::signals::FftConvolver: output must hold N + M - 1 samples");
+            }
+
+            std::vector<T> block(_fftSize);
+            std::vector<std::complex<T>> spectrum(_forward->spectrumSize());
+            if (_mode == BlockMode::OverlapAdd)
+            {
+                std::fill(y.begin(), y.end(), T(0));
+                for (int start = 0; start < inputLength; start += blockSize())
+                {
+                    const int count = std::min(blockSize(), inputLength - start);
+                    std::fill(block.begin(), block.end(), T(0));
+                    std::copy_n(x.begin() + start, count, block.begin());
+                    filterBlock(block, spectrum);
+
+                    const int produced = std::min(_fftSize, outputLength - start);
+                    for (int i = 0; i < produced; ++i)
+                    {
+                        y[start + i] += block[i];
+                    }
+                }
+            }
+            else
+            {
+                const int history = _impulseResponseLength - 1;
+                for (int start = 0; start < outputLength; start += blockSize())
+                {
+                    // Block covers input samples [start - (M - 1), start - (M - 1) + L)
+                    const int first = start - history;
+                    for (int i = 0; i < _fftSize; ++i)
+                    {
+                        const int n = first + i;
+                        block[i] = n >= 0 && n < inputLength ? x[n] : T(0);
+                    }
+                    filterBlock(block, spectrum);
+
+                    const int produced = std::min(blockSize(), outputLength - start);
+                    for (int i = 0; i < produced; ++i)
+                    {
+                        y[start + i] = block[history + i];
+                    }
+                }
+            }
+        }
+
+    private:
+        /**
+         * The requested FFT size, or the default for M taps if it is 0, once it is known to suit
+         * both the impulse response and fft::RealPlan.
+         */
+        static int validatedFftSize(int fftSize, int impulseResponseLength)
+        {
+            if (impulseResponseLength == 0)
+            {
+                throw std::invalid_argument("dsp::signals::FftConvolver: impulse response must not be empty");
+            }
+            const int size = fftSize > 0 ? fftSize : fft::nextPowerOfTwo(std::max(16, 4 * impulseResponseLength));
+            if (size <= impulseResponseLength)
+            {
+                throw std::invalid_argument("dsp::signals::FftConvolver: FFT size must exceed the impulse response length");
+            }
+            if (size % 2 != 0 || !fft::isSupportedSize(size / 2))
+            {
+                throw std::invalid_argument("dsp::signals::FftConvolver: FFT size must be even, with only prime factors 2, 3 and 5 in half of it");
+            }
+            return size;
+        }
+
+        void filterBlock(std::vector<T>& block, std::vector<std::complex<T>>& spectrum) const
+        {
+            _forward->execute(std::span<const T>(block), spectrum);
+            for (size_t k = 0; k < spectrum.size(); ++k)
+            {
+                spectrum[k] = fft::detail::multiply(spectrum[k], _kernelSpectrum[k]);
+            }
+            _inverse->execute(std::span<const std::complex<T>>(spectrum), block);
+        }
+
+        int _impulseResponseLength;
+        int _fftSize;
+        BlockMode _mode;
+        std::shared_ptr<const fft::RealPlan<T>> _forward;
+        std::shared_ptr<const fft::RealPlan<T>> _inverse;
+        std::vector<std::complex<T>> _kernelSpectrum;
+    };
+
+    /**
+     * FFT-based equivalent of convolve1D. Returns the same N + M - 1 sample output, computed
+     * block-wise with either overlap-add or overlap-save.
+     * @tparam T The input signal datatype. Must be float or double.
+     * @tparam InputSignalLength The length of the input signal in sample counts (N)
+     * @tparam ImpulseResponseLength The length of the impulse response in sample counts (M)
+     * @param x The input signal buffer
+     * @param h The impulse response buffer
+     * @param mode The block convolution algorithm to use
+     * @return The convolved output signal `y`
+     */
+    template<std::floating_point T, int InputSignalLength, int ImpulseResponseLength>
+    StaticBuffer<T, ImpulseResponseLength + InputSignalLength - 1>
+    fftConvolve1D(const StaticBuffer<T, InputSignalLength>& x,
+                  const StaticBuffer<T, ImpulseResponseLength>& h,
+                  BlockMode mode = BlockMode::OverlapSave)
+    {
+        // No point in blocks larger than the whole output
+        constexpr int fftSize = std::min(fft::nextPowerOfTwo(std::max(16, 4 * ImpulseResponseLength)),
+                                         fft::nextPowerOfTwo(InputSignalLength + ImpulseResponseLength));
+        StaticBuffer<T, ImpulseResponseLength + InputSignalLength - 1> y;
+        FftConvolver<T> convolver(std::span<const T>(h._data), mode, fftSize);
+        convolver.convolve(x._data, y._data);
+        return y;
+    }
+}
+
+#endif //SIGNAL_PROCESSING_BOOK_FAST_CONVOLUTION_H
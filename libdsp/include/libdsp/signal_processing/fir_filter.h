@@ -0,0 +1,103 @@
+#ifndef SIGNAL_PROCESSING_BOOK_FIR_FILTER_H
+#define SIGNAL_PROCESSING_BOOK_FIR_FILTER_H
+
+#include "libdsp/signal_processing/direct_convolution.h"
+#include "libdsp/storage/buffer.h"
+
+#include <algorithm>
+#include <concepts>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace dsp::signals
+{
+    /**
+     * Streaming direct-form FIR filter: y[n] = \sum_{j=0}^{M - 1} h[j]x[n - j], carried across calls.
+     *
+     * The last M - 1 input samples are kept in front of a staging window. Each block of input is
+     * appended behind them and the whole window goes through the vectorized convolveValid kernel,
+     * so every output sees exactly the history it would have in one long convolution, regardless
+     * of how the stream is cut into blocks. Afterwards the newest M - 1 samples slide to the front
+     * to become the history of the next block.
+     *
+     * Linear-phase (symmetric) and antisymmetric impulse responses are detected at construction and
+     * run on the folded kernel, which multiplies once per pair of mirrored taps.
+     * @tparam T The sample datatype. Must be float or double.
+     */
+    template<std::floating_point T>
+    class FirFilter
+    {
+    public:
+        /**
+         * @param h The impulse response (filter coefficients). Must not be empty.
+         */
+        explicit FirFilter(std::span<const T> h)
+            : _taps(h.begin(), h.end()),
+              _symmetry(firSymmetry(h.data(), static_cast<int>(h.size())))
+        {
+            if (_taps.empty())
+            {
+                throw std::invalid_argument("dsp::signals::FirFilter: impulse response must not be empty");
+            }
+            _window.resize(historyLength() + BLOCK_SIZE);
+            reset();
+        }
+
+        [[nodiscard]] int length() const { return static_cast<int>(_taps.size()); }
+        [[nodiscard]] std::span<const T> taps() const { return _taps; }
+        [[nodiscard]] FirSymmetry symmetry() const { return _symmetry; }
+
+        /**
+         * Clears the input history, as if the filter had only ever seen silence.
+         */
+        void reset()
+        {
+            std::fill(_window.begin(), _window.end(), T(0));
+        }
+
+        /**
+         * Filters `count` samples. Any block size works and never allocates.
+         * `input` and `output` may point to the same buffer.
+         */
+        void process(const T* input, T* output, int count)
+        {
+            const int history = historyLength();
+            while (count > 0)
+            {
+                const int chunk = std::min(count, BLOCK_SIZE);
+                std::copy_n(input, chunk, _window.begin() + history);
+                convolveValidFolded(_window.data(), history + chunk, _taps.data(), length(), _symmetry, output);
+                std::copy_n(_window.begin() + chunk, history, _window.begin());
+
+                input += chunk;
+                output += chunk;
+                count -= chunk;
+            }
+        }
+
+        /**
+         * Filters one libdsp buffer as the next block of the stream.
+         */
+        template<int N>
+        void process(const StaticBuffer<T, N>& input, StaticBuffer<T, N>& output)
+        {
+            process(input._data.data(), output._data.data(), N);
+        }
+
+    private:
+        /**
+         * Input samples staged per kernel call. Large enough to amortize the history shuffle, small
+         * enough that the window stays in L1.
+         */
+        static constexpr int BLOCK_SIZE = 256;
+
+        [[nodiscard]] int historyLength() const { return length() - 1; }
+
+        std::vector<T> _taps;
+        FirSymmetry _symmetry;
+        std::vector<T> _window; // [M - 1 samples of history][up to BLOCK_SIZE new samples]
+    };
+}
+
+#endif //SIGNAL_PROCESSING_BOOK_FIR_FILTER_H
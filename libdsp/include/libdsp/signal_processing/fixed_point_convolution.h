@@ -0,0 +1,101 @@
+#ifndef SIGNAL_PROCESSING_BOOK_FIXED_POINT_CONVOLUTION_H
+#define SIGNAL_PROCESSING_BOOK_FIXED_POINT_CONVOLUTION_H
+
+#include "libdsp/storage/buffer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace dsp::signals
+{
+    /**
+     * Converts a real value in [-1, 1) to Q15 (value * 2^15), rounding to nearest and saturating.
+     */
+    inline std::int16_t toQ15(double value)
+    {
+        return static_cast<std::int16_t>(std::clamp(std::lround(value * 32768.0), -32768L, 32767L));
+    }
+
+    inline double fromQ15(std::int16_t value)
+    {
+        return value / 32768.0;
+    }
+
+    /**
+     * Converts a real value in [-1, 1) to Q31 (value * 2^31), rounding to nearest and saturating.
+     */
+    inline std::int32_t toQ31(double value)
+    {
+        return static_cast<std::int32_t>(std::clamp(std::llround(value * 2147483648.0), -2147483648LL, 2147483647LL));
+    }
+
+    inline double fromQ31(std::int32_t value)
+    {
+        return value / 2147483648.0;
+    }
+
+    /**
+     * Fixed-point direct-form convolution of Q15 samples `x` (n samples) with Q15 taps `h` (m samples):
+     *   y[i] = sat(round(\sum_{j=0}^{m - 1} h[j]x[i - j] / 2^15)),  0 <= i < n + m - 1
+     * Products are summed exactly in a wide accumulator and only rounded (to nearest) and
+     * saturated to the int16 range once per output, so the result is what the exact sum would
+     * give no matter how the outputs are computed.
+     *
+     * When \sum |h| < 2 (every practical lowpass, and anything normalized for unity gain) a 32-bit
+     * accumulator can't overflow, and the steady state runs on the integer pairwise multiply-add
+     * kernels (pmaddwd on SSE2 / AVX2 / AVX-512BW, widening multiply-accumulate on NEON), picked
+     * like the floating point ones. Other taps fall back to a scalar 64-bit accumulator.
+     * @param y Output buffer of n + m - 1 samples. Must not overlap `x` or `h`.
+     */
+    void convolveDirectQ15(const std::int16_t* x, int n, const std::int16_t* h, int m, std::int16_t* y);
+
+    /**
+     * Only the outputs of convolveDirectQ15 where `h` fully overlaps `x`, as for convolveValid.
+     * @param y Output buffer of n - m + 1 samples. Must not overlap `x` or `h`. Requires n >= m.
+     */
+    void convolveValidQ15(const std::int16_t* x, int n, const std::int16_t* h, int m, std::int16_t* y);
+
+    /**
+     * convolveDirectQ15 for Q31 samples and taps, rounded and saturated to the int32 range.
+     * Sums go in 64 bits when \sum |h| < 2, which can't overflow; other taps use a 96-bit sum
+     * split over two 64-bit words. Either way the result is exact before the final rounding.
+     * @param y Output buffer of n + m - 1 samples. Must not overlap `x` or `h`.
+     */
+    void convolveDirectQ31(const std::int32_t* x, int n, const std::int32_t* h, int m, std::int32_t* y);
+
+    /**
+     * Only the outputs of convolveDirectQ31 where `h` fully overlaps `x`.
+     * @param y Output buffer of n - m + 1 samples. Must not overlap `x` or `h`. Requires n >= m.
+     */
+    void convolveValidQ31(const std::int32_t* x, int n, const std::int32_t* h, int m, std::int32_t* y);
+
+    /**
+     * convolve1D on Q15 libdsp buffers, e.g. raw 16-bit ADC samples, with rounding and saturation.
+     * @tparam InputSignalLength The length of the input signal in sample counts (N)
+     * @tparam ImpulseResponseLength The length of the impulse response in sample counts (M)
+     * @return The convolved output signal `y`, N + M - 1 samples long
+     */
+    template<int InputSignalLength, int ImpulseResponseLength>
+    StaticBuffer<std::int16_t, ImpulseResponseLength + InputSignalLength - 1>
+    convolve1DQ15(const StaticBuffer<std::int16_t, InputSignalLength>& x, const StaticBuffer<std::int16_t, ImpulseResponseLength>& h)
+    {
+        StaticBuffer<std::int16_t, ImpulseResponseLength + InputSignalLength - 1> y;
+        convolveDirectQ15(x._data.data(), InputSignalLength, h._data.data(), ImpulseResponseLength, y._data.data());
+        return y;
+    }
+
+    /**
+     * convolve1D on Q31 libdsp buffers, with rounding and saturation.
+     */
+    template<int InputSignalLength, int ImpulseResponseLength>
+    StaticBuffer<std::int32_t, ImpulseResponseLength + InputSignalLength - 1>
+    convolve1DQ31(const StaticBuffer<std::int32_t, InputSignalLength>& x, const StaticBuffer<std::int32_t, ImpulseResponseLength>& h)
+    {
+        StaticBuffer<std::int32_t, ImpulseResponseLength + InputSignalLength - 1> y;
+        convolveDirectQ31(x._data.data(), InputSignalLength, h._data.data(), ImpulseResponseLength, y._data.data());
+        return y;
+    }
+}
+
+#endif //SIGNAL_PROCESSING_BOOK_FIXED_POINT_CONVOLUTION_H
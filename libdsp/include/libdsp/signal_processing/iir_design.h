@@ -0,0 +1,180 @@
+#ifndef SIGNAL_PROCESSING_BOOK_IIR_DESIGN_H
+#define SIGNAL_PROCESSING_BOOK_IIR_DESIGN_H
+
+#include "libdsp/signal_processing/biquad.h"
+
+#include <cmath>
+#include <complex>
+#include <concepts>
+#include <numbers>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace dsp::signals
+{
+    namespace detail
+    {
+        inline void checkIirDesign(const char* name, int order, double cutoff)
+        {
+            if (order < 1)
+            {
+                throw std::invalid_argument(std::string("dsp::signals::") + name + ": order must be positive");
+            }
+            if (!(cutoff > 0.0 && cutoff < 0.5))
+            {
+                throw std::invalid_argument(std::string("dsp::signals::") + name + ": cutoff must be in (0, 0.5) cycles per sample");
+            }
+        }
+
+        /**
+         * Poles of an analog lowpass prototype with its band edge at 1 rad/s, one per conjugate pair
+         * (the one with positive imaginary part) and then the real pole of an odd order. Pole k of a
+         * Chebyshev type I prototype with ripple factor eps, mu = asinh(1 / eps) / order and
+         * theta_k = pi (2k + 1) / (2 order) is
+         *   -sinh(mu) sin(theta_k) + j cosh(mu) cos(theta_k)
+         * and Butterworth is the limit with both hyperbolic factors 1.
+         */
+        inline std::vector<std::complex<double>> prototypePoles(int order, double sinhMu, double coshMu)
+        {
+            std::vector<std::complex<double>> poles;
+            for (int k = 0; k < order / 2; ++k)
+            {
+                const double theta = std::numbers::pi * (2 * k + 1) / (2.0 * order);
+                poles.emplace_back(-sinhMu * std::sin(theta), coshMu * std::cos(theta));
+            }
+            if (order % 2 == 1)
+            {
+                poles.emplace_back(-sinhMu, 0.0);
+            }
+            return poles;
+        }
+
+        /**
+         * Maps prototype poles to digital sections with the bilinear transform, prewarped so the band
+         * edge lands exactly on `cutoff`. A lowpass scales each pole by K = tan(pi cutoff) and puts
+         * its zeros at z = -1; a highpass maps p to K / p and puts its zeros at z = 1. Each section
+         * gets unity gain at DC (lowpass) or Nyquist (highpass), times `gain` on the first.
+         * Sections are ordered by increasing Q, so the most resonant pole pair comes last and sees
+         * a signal the earlier sections have already band-limited.
+         */
+        template<std::floating_point T>
+        std::vector<Biquad<T>> bilinearSections(const std::vector<std::complex<double>>& poles, double cutoff, bool highpass, double gain)
+        {
+            const double k = std::tan(std::numbers::pi * cutoff);
+            const double zero = highpass ? 1.0 : -1.0;
+            std::vector<Biquad<T>> sections;
+            for (auto it = poles.rbegin(); it != poles.rend(); ++it)
+            {
+                const std::complex<double> analog = highpass ? k / *it : k * *it;
+                const std::complex<double> pole = (1.0 + analog) / (1.0 - analog);
+
+                double b1 = -zero;
+                double b2 = 0.0;
+                double a1 = -pole.real();
+                double a2 = 0.0;
+                if (it->imag() != 0.0)
+                {
+                    // (1 - zero z^-1)^2 over (1 - pole z^-1)(1 - conj(pole) z^-1)
+                    b1 = -2.0 * zero;
+                    b2 = 1.0;
+                    a1 = -2.0 * pole.real();
+                    a2 = std::norm(pole);
+                }
+                // Evaluate numerator and denominator at the passband centre z = -zero
+                const double numerator = 1.0 - b1 * zero + b2;
+                const double denominator = 1.0 - a1 * zero + a2;
+                double g = denominator / numerator;
+                if (sections.empty())
+                {
+                    g *= gain;
+                }
+                sections.push_back({T(g), T(g * b1), T(g * b2), T(a1), T(a2)});
+            }
+            return sections;
+        }
+
+        template<std::floating_point T>
+        std::vector<Biquad<T>> chebyshevSections(const char* name, int order, double rippleDb, double cutoff, bool highpass)
+        {
+            checkIirDesign(name, order, cutoff);
+            if (!(rippleDb > 0.0))
+            {
+                throw std::invalid_argument(std::string("dsp::signals::") + name + ": passband ripple must be positive");
+            }
+            const double epsilon = std::sqrt(std::pow(10.0, rippleDb / 10.0) - 1.0);
+            const double mu = std::asinh(1.0 / epsilon) / order;
+            // An even order starts its passband at the bottom of the ripple; an odd one at the top
+            const double gain = order % 2 == 0 ? 1.0 / std::sqrt(1.0 + epsilon * epsilon) : 1.0;
+            return bilinearSections<T>(prototypePoles(order, std::sinh(mu), std::cosh(mu)), cutoff, highpass, gain);
+        }
+    }
+
+    /**
+     * Butterworth lowpass: maximally flat passband, -3 dB at `cutoff`, rolling off at 6 * order dB
+     * per octave.
+     * @param order The filter order; (order + 1) / 2 sections. Must be positive.
+     * @param cutoff The -3 dB frequency in cycles per sample, in (0, 0.5).
+     */
+    template<std::floating_point T = double>
+    std::vector<Biquad<T>> butterworthLowpass(int order, double cutoff)
+    {
+        detail::checkIirDesign("butterworthLowpass", order, cutoff);
+        return detail::bilinearSections<T>(detail::prototypePoles(order, 1.0, 1.0), cutoff, false, 1.0);
+    }
+
+    /**
+     * Butterworth highpass, the mirror image of butterworthLowpass.
+     */
+    template<std::floating_point T = double>
+    std::vector<Biquad<T>> butterworthHighpass(int order, double cutoff)
+    {
+        detail::checkIirDesign("butterworthHighpass", order, cutoff);
+        return detail::bilinearSections<T>(detail::prototypePoles(order, 1.0, 1.0), cutoff, true, 1.0);
+    }
+
+    /**
+     * Chebyshev type I lowpass: the gain ripples between 1 and -rippleDb dB across the passband in
+     * exchange for a steeper transition than a Butterworth of the same order.
+     * @param order The filter order; (order + 1) / 2 sections. Must be positive.
+     * @param rippleDb The peak-to-peak passband ripple in dB. Must be positive.
+     * @param cutoff The passband edge (where the gain last drops to -rippleDb dB) in cycles per
+     *               sample, in (0, 0.5).
+     */
+    template<std::floating_point T = double>
+    std::vector<Biquad<T>> chebyshevLowpass(int order, double rippleDb, double cutoff)
+    {
+        return detail::chebyshevSections<T>("chebyshevLowpass", order, rippleDb, cutoff, false);
+    }
+
+    /**
+     * Chebyshev type I highpass, the mirror image of chebyshevLowpass.
+     */
+    template<std::floating_point T = double>
+    std::vector<Biquad<T>> chebyshevHighpass(int order, double rippleDb, double cutoff)
+    {
+        return detail::chebyshevSections<T>("chebyshevHighpass", order, rippleDb, cutoff, true);
+    }
+
+    /**
+     * Second-order notch (the RBJ audio EQ cookbook design): zeros on the unit circle at
+     * `frequency`, unity gain away from it.
+     * @param frequency The rejected frequency in cycles per sample, in (0, 0.5).
+     * @param q Centre frequency over the -3 dB bandwidth; larger is narrower. Must be positive.
+     */
+    template<std::floating_point T = double>
+    Biquad<T> notch(double frequency, double q)
+    {
+        if (!(frequency > 0.0 && frequency < 0.5) || !(q > 0.0))
+        {
+            throw std::invalid_argument("dsp::signals::notch: frequency must be in (0, 0.5) and q positive");
+        }
+        const double w0 = 2.0 * std::numbers::pi * frequency;
+        const double alpha = std::sin(w0) / (2.0 * q);
+        const double a0 = 1.0 + alpha;
+        const double c = -2.0 * std::cos(w0) / a0;
+        return {T(1.0 / a0), T(c), T(1.0 / a0), T(c), T((1.0 - alpha) / a0)};
+    }
+}
+
+#endif //SIGNAL_PROCESSING_BOOK_IIR_DESIGN_H
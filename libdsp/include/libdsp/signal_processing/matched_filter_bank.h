@@ -0,0 +1,251 @@
+#ifndef SIGNAL_PROCESSING_BOOK_MATCHED_FILTER_BANK_H
+#define SIGNAL_PROCESSING_BOOK_MATCHED_FILTER_BANK_H
+
+#include "libdsp/fft/plan_cache.h"
+#include "libdsp/platform/thread_pool.h"
+#include "libdsp/signal_processing/correlation.h"
+#include "libdsp/signal_processing/signal_processing.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <concepts>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace dsp::signals
+{
+    /**
+     * Which correlation value counts as a template's peak.
+     *  - Largest: the most positive value, for templates that can only match with their own polarity
+     *  - LargestMagnitude: the value furthest from zero, so an inverted match also counts
+     */
+    enum class PeakSearch
+    {
+        Largest,
+        LargestMagnitude
+    };
+
+    /**
+     * Best match of one template against an input window.
+     */
+    template<std::floating_point T>
+    struct MatchedFilterPeak
+    {
+        /** Lag of the peak, as in correlate(): the template best lines up with window[lag]. */
+        int lag = 0;
+        /** Correlation value at that lag, after scaling. */
+        T value = 0;
+    };
+
+    /**
+     * Correlates input windows against a bank of template waveforms in one pass.
+     *
+     * Each template is transformed once when it is added, and its conjugate spectrum is kept.
+     * A window is then transformed once, and every template only costs a spectrum multiply and
+     * an inverse transform, instead of re-reading the window per template. detect() scans each
+     * template's correlation for its peak in a per-thread scratch buffer and only returns the
+     * peaks, so the full outputs are never stored; correlate() returns one in full when needed.
+     *
+     * Lags and regions follow correlate(window, template).
+     * @tparam T The sample datatype. Must be float or double.
+     */
+    template<std::floating_point T>
+    class MatchedFilterBank
+    {
+    public:
+        /**
+         * An empty bank; add templates with addTemplate().
+         * @param maxWindowLength The longest window detect() and correlate() will be given.
+         * @param maxTemplateLength The longest template addTemplate() will be given.
+         */
+        MatchedFilterBank(int maxWindowLength, int maxTemplateLength)
+            : _maxWindowLength(maxWindowLength), _maxTemplateLength(maxTemplateLength)
+        {
+            if (maxWindowLength < 1 || maxTemplateLength < 1)
+            {
+                throw std::invalid_argument("dsp::signals::MatchedFilterBank: window and template lengths must be positive");
+            }
+            _fftSize = std::max(2, fft::nextPowerOfTwo(maxWindowLength + maxTemplateLength - 1));
+            _forward = fft::PlanCache::instance().realPlan<T>(_fftSize, fft::Direction::Forward);
+            _inverse = fft::PlanCache::instance().realPlan<T>(_fftSize, fft::Direction::Inverse);
+        }
+
+        /**
+         * A bank holding `templates`, sized for their longest one.
+         */
+        MatchedFilterBank(std::span<const std::span<const T>> templates, int maxWindowLength)
+            : MatchedFilterBank(maxWindowLength, longest(templates))
+        {
+            for (const auto& waveform : templates)
+            {
+                addTemplate(waveform);
+            }
+        }
+
+        /**
+         * Transforms `waveform` and stores its spectrum in the bank.
+         * @return The template's index in detect()'s results.
+         */
+        int addTemplate(std::span<const T> waveform)
+        {
+            if (waveform.empty() || static_cast<int>(waveform.size()) > _maxTemplateLength)
+            {
+                throw std::invalid_argument("dsp::signals::MatchedFilterBank: template must be 1 ... maxTemplateLength samples");
+            }
+
+            std::vector<T> padded(_fftSize, T(0));
+            std::copy(waveform.begin(), waveform.end(), padded.begin());
+            const size_t bins = _forward->spectrumSize();
+            _spectra.resize(_spectra.size() + bins);
+            const std::span<std::complex<T>> spectrum(_spectra.data() + _spectra.size() - bins, bins);
+            _forward->execute(std::span<const T>(padded), spectrum);
+            for (auto& bin : spectrum)
+            {
+                bin = std::conj(bin);
+            }
+
+            _lengths.push_back(static_cast<int>(waveform.size()));
+            _energies.push_back(detail::energy(waveform));
+            return templateCount() - 1;
+        }
+
+        [[nodiscard]] int templateCount() const { return static_cast<int>(_lengths.size()); }
+        [[nodiscard]] int templateLength(int index) const { return _lengths[index]; }
+        [[nodiscard]] int maxWindowLength() const { return _maxWindowLength; }
+        [[nodiscard]] int fftSize() const { return _fftSize; }
+
+        /**
+         * Correlates `window` against every template and finds each one's peak within `region`.
+         * @return One peak per template, in template order. Templates whose region is empty
+         *         (e.g. Valid with a template longer than the window) report lag 0 and value 0.
+         */
+        std::vector<MatchedFilterPeak<T>> detect(std::span<const T> window,
+                                                 ConvolutionRegion region = ConvolutionRegion::Full,
+                                                 CorrelationScaling scaling = CorrelationScaling::None,
+                                                 PeakSearch search = PeakSearch::Largest,
+                                                 platform::ThreadPool& pool = platform::ThreadPool::shared()) const
+        {
+            const std::vector<std::complex<T>> windowSpectrum = transform(window);
+            const double windowEnergy = detail::energy(window);
+            std::vector<MatchedFilterPeak<T>> peaks(templateCount());
+
+            pool.parallelFor(templateCount(), 1, [&](int begin, int end) {
+                std::vector<std::complex<T>> product(windowSpectrum.size());
+                std::vector<T> circular(_fftSize);
+                std::vector<T> r;
+                for (int index = begin; index < end; ++index)
+                {
+                    const int firstLag = extract(windowSpectrum, window.size(), windowEnergy, index, region, scaling,
+                                                 product, circular, r);
+                    if (r.empty())
+                    {
+                        continue;
+                    }
+
+                    auto best = r.begin();
+                    if (search == PeakSearch::Largest)
+                    {
+                        best = std::max_element(r.begin(), r.end());
+                    }
+                    else
+                    {
+                        best = std::max_element(r.begin(), r.end(), [](T a, T b) { return std::abs(a) < std::abs(b); });
+                    }
+                    peaks[index] = {firstLag + static_cast<int>(best - r.begin()), *best};
+                }
+            });
+            return peaks;
+        }
+
+        /**
+         * The full correlation of `window` against template `index`, as correlate() would return it.
+         */
+        std::vector<T> correlate(std::span<const T> window, int index,
+                                 ConvolutionRegion region = ConvolutionRegion::Full,
+                                 CorrelationScaling scaling = CorrelationScaling::None) const
+        {
+            if (index < 0 || index >= templateCount())
+            {
+                throw std::out_of_range("dsp::signals::MatchedFilterBank: no template with that index");
+            }
+            const std::vector<std::complex<T>> windowSpectrum = transform(window);
+            std::vector<std::complex<T>> product(windowSpectrum.size());
+            std::vector<T> circular(_fftSize);
+            std::vector<T> r;
+            extract(windowSpectrum, window.size(), detail::energy(window), index, region, scaling, product, circular, r);
+            return r;
+        }
+
+    private:
+        static int longest(std::span<const std::span<const T>> templates)
+        {
+            size_t length = 1;
+            for (const auto& waveform : templates)
+            {
+                length = std::max(length, waveform.size());
+            }
+            return static_cast<int>(length);
+        }
+
+        std::vector<std::complex<T>> transform(std::span<const T> window) const
+        {
+            if (window.empty() || static_cast<int>(window.size()) > _maxWindowLength)
+            {
+                throw std::invalid_argument("dsp::signals::MatchedFilterBank: window must be 1 ... maxWindowLength samples");
+            }
+            std::vector<T> padded(_fftSize, T(0));
+            std::copy(window.begin(), window.end(), padded.begin());
+            std::vector<std::complex<T>> spectrum(_forward->spectrumSize());
+            _forward->execute(std::span<const T>(padded), spectrum);
+            return spectrum;
+        }
+
+        /**
+         * Writes template `index`'s scaled correlation over `region` into r.
+         * @return The lag of r[0].
+         */
+        int extract(const std::vector<std::complex<T>>& windowSpectrum, size_t windowLength, double windowEnergy,
+                    int index, ConvolutionRegion region, CorrelationScaling scaling,
+                    std::vector<std::complex<T>>& product, std::vector<T>& circular, std::vector<T>& r) const
+        {
+            const int n = static_cast<int>(windowLength);
+            const int m = _lengths[index];
+            const auto [offset, length] = regionBounds(region, n, m);
+            r.resize(length);
+            if (length == 0)
+            {
+                return 0;
+            }
+
+            const std::complex<T>* spectrum = _spectra.data() + static_cast<size_t>(index) * product.size();
+            for (size_t k = 0; k < product.size(); ++k)
+            {
+                product[k] = fft::detail::multiply(windowSpectrum[k], spectrum[k]);
+            }
+            _inverse->execute(std::span<const std::complex<T>>(product), circular);
+
+            // The transform is at least N + M - 1 points, so lag k sits at (k + L) % L without wrapping
+            const int firstLag = offset - (m - 1);
+            for (int i = 0; i < length; ++i)
+            {
+                r[i] = circular[(firstLag + i + _fftSize) % _fftSize];
+            }
+            detail::scale(std::span<T>(r), firstLag, n, m, std::sqrt(windowEnergy * _energies[index]), scaling);
+            return firstLag;
+        }
+
+        int _maxWindowLength;
+        int _maxTemplateLength;
+        int _fftSize = 0;
+        std::shared_ptr<const fft::RealPlan<T>> _forward;
+        std::shared_ptr<const fft::RealPlan<T>> _inverse;
+        std::vector<std::complex<T>> _spectra; // Conjugated template spectra, one after another
+        std::vector<int> _lengths;
+        std::vector<double> _energies;
+    };
+}
+
+#endif //SIGNAL_PROCESSING_BOOK_MATCHED_FILTER_BANK_H
@@ -0,0 +1,277 @@
+#ifndef SIGNAL_PROCESSING_BOOK_MOVING_AVERAGE_H
+#define SIGNAL_PROCESSING_BOOK_MOVING_AVERAGE_H
+
+#include "libdsp/signal_processing/signal_processing.h"
+#include "libdsp/storage/buffer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace dsp::signals
+{
+    /**
+     * Streaming running sum over the last M samples, y[n] = \sum_{j=0}^{M - 1} x[n - j], in O(1) per
+     * sample and without drift.
+     *
+     * The textbook recursion y[n] = y[n - 1] + x[n] - x[n - M] is O(1) too, but every rounding error
+     * it makes stays in y forever, so over a long stream the sum wanders off (and never returns to
+     * exactly 0 on silence). Instead the stream is cut into blocks of M samples. A window ending in
+     * block b covers the tail of block b - 1 and the head of block b, so its sum is a suffix sum of
+     * the previous block plus a prefix sum of the current one. The prefix sum is accumulated as
+     * samples arrive, and the suffix sums of a block are computed in one backward pass when it
+     * completes, so each output costs about three additions. Every output is a fresh sum of at most
+     * 2M samples, and its error is bounded no matter how long the stream runs. Sums are kept in
+     * double (or wider T).
+     * @tparam T The sample datatype. Must be float or double.
+     */
+    template<std::floating_point T>
+    class MovingSum
+    {
+    public:
+        /**
+         * @param length The window length M. Must be positive.
+         */
+        explicit MovingSum(int length) : MovingSum(length, 1.0) {}
+
+        [[nodiscard]] int length() const { return _length; }
+
+        /**
+         * Clears the history, as if the filter had only ever seen silence.
+         */
+        void reset()
+        {
+            std::fill(_block.begin(), _block.end(), T(0));
+            std::fill(_suffix.begin(), _suffix.end(), Accumulator(0));
+            _prefix = 0;
+            _phase = 0;
+        }
+
+        /**
+         * Filters `count` samples. Any block size works and never allocates.
+         * `input` and `output` may point to the same buffer.
+         */
+        void process(const T* input, T* output, int count)
+        {
+            while (count > 0)
+            {
+                // Window [n - M + 1, n] = previous block from offset _phase + 1, current block up to _phase
+                const int run = std::min(count, _length - _phase);
+                T* block = _block.data() + _phase;
+                const Accumulator* suffix = _suffix.data() + _phase + 1;
+                Accumulator prefix = _prefix;
+                for (int i = 0; i < run; ++i)
+                {
+                    const T x = input[i];
+                    block[i] = x;
+                    prefix += x;
+                    output[i] = static_cast<T>((suffix[i] + prefix) * _scale);
+                }
+                _prefix = prefix;
+                _phase += run;
+                if (_phase == _length)
+                {
+                    completeBlock();
+                }
+                input += run;
+                output += run;
+                count -= run;
+            }
+        }
+
+        /**
+         * Filters one libdsp buffer as the next block of the stream.
+         */
+        template<int N>
+        void process(const StaticBuffer<T, N>& input, StaticBuffer<T, N>& output)
+        {
+            process(input._data.data(), output._data.data(), N);
+        }
+
+    protected:
+        using Accumulator = std::common_type_t<T, double>;
+
+        /**
+         * @param scale Applied to every output sum.
+         */
+        MovingSum(int length, double scale) : _length(length), _scale(static_cast<Accumulator>(scale))
+        {
+            if (length < 1)
+            {
+                throw std::invalid_argument("dsp::signals::MovingSum: window length must be positive");
+            }
+            _block.resize(length);
+            _suffix.resize(length + 1);
+            reset();
+        }
+
+    private:
+        /**
+         * The block just filled becomes the previous block: store its suffix sums and start a new prefix.
+         */
+        void completeBlock()
+        {
+            Accumulator sum = 0;
+            for (int k = _length - 1; k >= 0; --k)
+            {
+                sum += _block[k];
+                _suffix[k] = sum;
+            }
+            _prefix = 0;
+            _phase = 0;
+        }
+
+        int _length;
+        Accumulator _scale;
+        std::vector<T> _block;            // the current block, up to _phase
+        std::vector<Accumulator> _suffix; // _suffix[k] = sum of previous block from k on; _suffix[M] = 0
+        Accumulator _prefix = 0;          // sum of the current block up to _phase
+        int _phase = 0;                   // position of the next sample in the current block
+    };
+
+    /**
+     * Streaming M-sample moving average, y[n] = (1 / M) \sum_{j=0}^{M - 1} x[n - j]: a MovingSum
+     * scaled by 1 / M, so O(1) per sample whatever the window length.
+     * @tparam T The sample datatype. Must be float or double.
+     */
+    template<std::floating_point T>
+    class MovingAverage : public MovingSum<T>
+    {
+    public:
+        /**
+         * @param length The window length M. Must be positive.
+         */
+        explicit MovingAverage(int length) : MovingSum<T>(length, 1.0 / std::max(length, 1)) {}
+    };
+
+    /**
+     * Streaming cascade of identical moving averages. K passes of an M-sample box have a
+     * K(M - 1) + 1 sample impulse response that converges quickly on a Gaussian (a B-spline of
+     * degree K - 1): 3 passes are within a few percent, with variance K(M^2 - 1) / 12. See
+     * gaussianBoxLength to pick M for a given sigma. Still O(K) per sample, independent of M.
+     * @tparam T The sample datatype. Must be float or double.
+     */
+    template<std::floating_point T>
+    class CascadedMovingAverage
+    {
+    public:
+        /**
+         * @param length The window length M of each pass. Must be positive.
+         * @param passes The number of passes K. Must be positive.
+         */
+        CascadedMovingAverage(int length, int passes)
+        {
+            if (passes < 1)
+            {
+                throw std::invalid_argument("dsp::signals::CascadedMovingAverage: pass count must be positive");
+            }
+            _stages.assign(passes, MovingAverage<T>(length));
+        }
+
+        [[nodiscard]] int length() const { return _stages.front().length(); }
+        [[nodiscard]] int passes() const { return static_cast<int>(_stages.size()); }
+
+        void reset()
+        {
+            for (MovingAverage<T>& stage : _stages)
+            {
+                stage.reset();
+            }
+        }
+
+        /**
+         * Filters `count` samples. `input` and `output` may point to the same buffer.
+         */
+        void process(const T* input, T* output, int count)
+        {
+            _stages.front().process(input, output, count);
+            for (std::size_t k = 1; k < _stages.size(); ++k)
+            {
+                _stages[k].process(output, output, count);
+            }
+        }
+
+        template<int N>
+        void process(const StaticBuffer<T, N>& input, StaticBuffer<T, N>& output)
+        {
+            process(input._data.data(), output._data.data(), N);
+        }
+
+    private:
+        std::vector<MovingAverage<T>> _stages;
+    };
+
+    /**
+     * The box length M whose `passes`-fold cascade has standard deviation closest to `sigma`,
+     * from sigma^2 = K(M^2 - 1) / 12.
+     * @param sigma The target standard deviation in samples. Must be positive.
+     */
+    inline int gaussianBoxLength(double sigma, int passes)
+    {
+        if (!(sigma > 0.0) || passes < 1)
+        {
+            throw std::invalid_argument("dsp::signals::gaussianBoxLength: sigma and pass count must be positive");
+        }
+        return std::max(1, static_cast<int>(std::lround(std::sqrt(12.0 * sigma * sigma / passes + 1.0))));
+    }
+
+    namespace detail
+    {
+        /**
+         * `passes` full-length passes of `stage`-type filters over x, then the requested region.
+         * Each pass is the stream x followed by M - 1 zeros, so its output is the full convolution.
+         */
+        template<typename Stage, typename T>
+        std::vector<T> boxFilter(std::span<const T> x, int length, int passes, ConvolutionRegion region)
+        {
+            if (length < 1 || passes < 1)
+            {
+                throw std::invalid_argument("dsp::signals::movingAverage: window length and pass count must be positive");
+            }
+            const int n = static_cast<int>(x.size());
+            if (n == 0)
+            {
+                return {};
+            }
+            const int tail = length - 1;
+            std::vector<T> y(n + passes * tail, T(0));
+            std::copy(x.begin(), x.end(), y.begin());
+            for (int pass = 0, size = n; pass < passes; ++pass, size += tail)
+            {
+                Stage stage(length);
+                stage.process(y.data(), y.data(), size + tail);
+            }
+            const auto [offset, count] = regionBounds(region, n, passes * tail + 1);
+            return {y.begin() + offset, y.begin() + offset + count};
+        }
+    }
+
+    /**
+     * Moving average of a whole buffer in O(1) per sample; the same as convolve1D with an M-sample
+     * kernel of 1 / M (up to rounding, which is tighter here), or with its `passes`-fold
+     * self-convolution for a multi-pass, Gaussian-like smoother.
+     * @param length The window length M. Must be positive.
+     * @param region Which outputs to return, for the combined K(M - 1) + 1 sample kernel.
+     * @param passes The number of moving-average passes K. Must be positive.
+     */
+    template<std::floating_point T>
+    std::vector<T> movingAverage(std::span<const T> x, int length, ConvolutionRegion region = ConvolutionRegion::Full, int passes = 1)
+    {
+        return detail::boxFilter<MovingAverage<T>>(x, length, passes, region);
+    }
+
+    /**
+     * Running sum of a whole buffer over M-sample windows, as movingAverage without the 1 / M.
+     */
+    template<std::floating_point T>
+    std::vector<T> movingSum(std::span<const T> x, int length, ConvolutionRegion region = ConvolutionRegion::Full)
+    {
+        return detail::boxFilter<MovingSum<T>>(x, length, 1, region);
+    }
+}
+
+#endif //SIGNAL_PROCESSING_BOOK_MOVING_AVERAGE_H
@@ -0,0 +1,378 @@
+#ifndef SIGNAL_PROCESSING_BOOK_MULTIRATE_H
+#define SIGNAL_PROCESSING_BOOK_MULTIRATE_H
+
+#include "libdsp/signal_processing/direct_convolution.h"
+#include "libdsp/signal_processing/windows.h"
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace dsp::signals
+{
+    /**
+     * Streaming FIR decimator: low-pass filters and keeps every `factor`-th output,
+     *   y[k] = \sum_{j=0}^{M - 1} h[j]x[k * factor - j]
+     *
+     * Only the kept outputs are ever computed, so this does 1 / factor of the multiply-adds of
+     * filtering followed by downsampling. With the taps stored in reverse, each kept output is one
+     * contiguous dotProduct over the input history, which is the polyphase decomposition summed in
+     * input order.
+     *
+     * The first output lines up with the first input sample (y[0] = h[0]x[0]), and the phase is
+     * carried across calls, so any block size works.
+     * @tparam T The sample datatype. Must be float or double.
+     */
+    template<std::floating_point T>
+    class FirDecimator
+    {
+    public:
+        /**
+         * @param h The anti-aliasing filter. Must not be empty.
+         * @param factor The downsampling factor D. Must be positive.
+         */
+        FirDecimator(std::span<const T> h, int factor)
+            : _factor(factor),
+              _reversedTaps(h.rbegin(), h.rend())
+        {
+            if (_reversedTaps.empty() || factor < 1)
+            {
+                throw std::invalid_argument("dsp::signals::FirDecimator: need a non-empty filter and a positive factor");
+            }
+            _window.resize(historyLength() + BLOCK_SIZE);
+            reset();
+        }
+
+        [[nodiscard]] int factor() const { return _factor; }
+
+        /**
+         * @return The most outputs a call to process() with `inputCount` samples can produce.
+         */
+        [[nodiscard]] int maxOutputCount(int inputCount) const
+        {
+            return (inputCount + _factor - 1) / _factor;
+        }
+
+        /**
+         * Clears the input history and restarts the output phase at the next input sample.
+         */
+        void reset()
+        {
+            std::fill(_window.begin(), _window.end(), T(0));
+            _skip = 0;
+        }
+
+        /**
+         * Filters `count` input samples and writes the kept outputs. Never allocates.
+         * @param output Room for at least maxOutputCount(count) samples.
+         * @return The number of outputs written.
+         */
+        int process(const T* input, int count, T* output)
+        {
+            const int history = historyLength();
+            const int taps = static_cast<int>(_reversedTaps.size());
+            int written = 0;
+            while (count > 0)
+            {
+                const int chunk = std::min(count, BLOCK_SIZE);
+                std::copy_n(input, chunk, _window.begin() + history);
+
+                // The output aligned with new sample r reads _window[r, r + M)
+                int r = _skip;
+                for (; r < chunk; r += _factor)
+                {
+                    output[written++] = dotProduct(_reversedTaps.data(), _window.data() + r, taps);
+                }
+                _skip = r - chunk;
+
+                std::copy_n(_window.begin() + chunk, history, _window.begin());
+                input += chunk;
+                count -= chunk;
+            }
+            return written;
+        }
+
+    private:
+        static constexpr int BLOCK_SIZE = 1024;
+
+        [[nodiscard]] int historyLength() const { return static_cast<int>(_reversedTaps.size()) - 1; }
+
+        int _factor;
+        std::vector<T> _reversedTaps;
+        std::vector<T> _window; // [M - 1 samples of history][up to BLOCK_SIZE new samples]
+        int _skip = 0;          // New samples to skip before the next kept output
+    };
+
+    /**
+     * Kaiser-windowed half-band lowpass of `length` = 4L - 1 taps, the usual anti-aliasing filter for
+     * decimating by 2: cutoff at a quarter of the sample rate, symmetric, and with every tap an even
+     * distance from the centre c = 2L - 1 exactly zero:
+     *   h[c] = 0.5,  h[c + i] = 0.5 sinc(i / 2) w(i / (c + 1)) for odd i
+     * The odd taps are scaled to sum to 0.5, for exactly unity gain at DC.
+     * @param length The tap count. Must be 3, 7, 11, ...
+     * @param beta The Kaiser window shape (see kaiserWindow); larger trades transition width for
+     *             stopband attenuation.
+     */
+    template<std::floating_point T>
+    std::vector<T> halfBandLowpass(int length, double beta)
+    {
+        if (length < 3 || length % 4 != 3)
+        {
+            throw std::invalid_argument("dsp::signals::halfBandLowpass: length must be 4L - 1 for some L >= 1");
+        }
+        const int centre = (length - 1) / 2;
+        std::vector<double> taps(length, 0.0);
+        double sum = 0.0;
+        for (int i = 1; i <= centre; i += 2)
+        {
+            const double tap = 0.5 * sinc(i / 2.0) * kaiserWindow(i / (centre + 1.0), beta);
+            taps[centre - i] = tap;
+            taps[centre + i] = tap;
+            sum += 2.0 * tap;
+        }
+        std::vector<T> h(length);
+        for (int j = 0; j < length; ++j)
+        {
+            h[j] = static_cast<T>(taps[j] * 0.5 / sum);
+        }
+        h[centre] = T(0.5);
+        return h;
+    }
+
+    /**
+     * Streaming decimate-by-2 with a half-band filter: FirDecimator with factor 2, computed
+     * as in that class (y[k] = \sum_{j=0}^{M - 1} h[j]x[2k - j], first output aligned with x[0]),
+     * but at about a quarter of the multiplies.
+     *
+     * With M = 4L - 1 taps and centre c = 2L - 1, the taps at even distances from the centre are
+     * zero. Every remaining tap but the centre one has an even index, so it only ever meets even
+     * input samples. Splitting the input into E[i] = x[2i] and O[i] = x[2i + 1] gives
+     *   y[k] = \sum_{p=0}^{2L - 1} h[2p] E[k - p] + h[c] O[k - L]
+     * a plain convolution at the output rate with the 2L even taps, which are symmetric, so the
+     * folded kernel does it in L multiplies, plus one for the centre tap: (M + 1) / 4 + 1 per output
+     * against M for FirDecimator.
+     * @tparam T The sample datatype. Must be float or double.
+     */
+    template<std::floating_point T>
+    class HalfBandDecimator
+    {
+    public:
+        /**
+         * @param h A half-band filter of 4L - 1 taps, e.g. from halfBandLowpass. Taps at even
+         *          distances from the centre are taken as zero, and must be negligible (within 1e-9
+         *          of the largest tap) in `h`.
+         */
+        explicit HalfBandDecimator(std::span<const T> h)
+        {
+            const int length = static_cast<int>(h.size());
+            if (length < 3 || length % 4 != 3)
+            {
+                throw std::invalid_argument("dsp::signals::HalfBandDecimator: filter length must be 4L - 1 for some L >= 1");
+            }
+            const int centre = (length - 1) / 2;
+            T largest = 0;
+            for (T tap : h)
+            {
+                largest = std::max(largest, std::abs(tap));
+            }
+            for (int j = 1; j < length; j += 2)
+            {
+                if (j != centre && std::abs(h[j]) > T(1e-9) * largest)
+                {
+                    throw std::invalid_argument("dsp::signals::HalfBandDecimator: not a half-band filter; taps an even distance from the centre must be zero");
+                }
+            }
+
+            for (int j = 0; j < length; j += 2)
+            {
+                _evenTaps.push_back(h[j]);
+            }
+            _centreTap = h[centre];
+            _symmetry = firSymmetry(_evenTaps.data(), static_cast<int>(_evenTaps.size()));
+            _even.resize(evenHistory() + BLOCK_SIZE / 2);
+            _odd.resize(oddHistory() + BLOCK_SIZE / 2);
+            reset();
+        }
+
+        [[nodiscard]] int factor() const { return 2; }
+
+        /**
+         * @return The most outputs a call to process() with `inputCount` samples can produce.
+         */
+        [[nodiscard]] int maxOutputCount(int inputCount) const
+        {
+            return (inputCount + 1) / 2;
+        }
+
+        /**
+         * Clears the input history and restarts the output phase at the next input sample.
+         */
+        void reset()
+        {
+            std::fill(_even.begin(), _even.end(), T(0));
+            std::fill(_odd.begin(), _odd.end(), T(0));
+            _phase = 0;
+        }
+
+        /**
+         * Filters `count` input samples and writes the kept outputs. Never allocates.
+         * @param output Room for at least maxOutputCount(count) samples.
+         * @return The number of outputs written.
+         */
+        int process(const T* input, int count, T* output)
+        {
+            int written = 0;
+            while (count > 0)
+            {
+                const int chunk = std::min(count, BLOCK_SIZE);
+                int evens = 0;
+                int odds = 0;
+                for (int i = 0; i < chunk; ++i)
+                {
+                    if ((_phase + i) % 2 == 0)
+                    {
+                        _even[evenHistory() + evens++] = input[i];
+                    }
+                    else
+                    {
+                        _odd[oddHistory() + odds++] = input[i];
+                    }
+                }
+
+                convolveValidFolded(_even.data(), evenHistory() + evens, _evenTaps.data(),
+                                    static_cast<int>(_evenTaps.size()), _symmetry, output + written);
+                // O[k - L] sits _phase places further on when the chunk started on an odd sample,
+                // since one more even than odd sample had arrived before it
+                const T* odd = _odd.data() + _phase;
+                for (int k = 0; k < evens; ++k)
+                {
+                    output[written + k] += _centreTap * odd[k];
+                }
+
+                std::copy_n(_even.begin() + evens, evenHistory(), _even.begin());
+                std::copy_n(_odd.begin() + odds, oddHistory(), _odd.begin());
+                _phase = (_phase + chunk) % 2;
+                written += evens;
+                input += chunk;
+                count -= chunk;
+            }
+            return written;
+        }
+
+    private:
+        static constexpr int BLOCK_SIZE = 1024;
+
+        [[nodiscard]] int evenHistory() const { return static_cast<int>(_evenTaps.size()) - 1; }
+        [[nodiscard]] int oddHistory() const { return static_cast<int>(_evenTaps.size()) / 2; }
+
+        std::vector<T> _evenTaps; // h[0], h[2], ..., h[M - 1]
+        T _centreTap = 0;
+        FirSymmetry _symmetry = FirSymmetry::None;
+        std::vector<T> _even; // [2L - 1 even samples of history][up to BLOCK_SIZE / 2 new ones]
+        std::vector<T> _odd;  // [L odd samples of history][up to BLOCK_SIZE / 2 new ones]
+        int _phase = 0;       // Parity of the next input sample's index
+    };
+
+    /**
+     * Streaming polyphase FIR interpolator: upsamples by `factor` and low-pass filters,
+     *   y[n] = \sum_{j=0}^{M - 1} h[j]u[n - j],  u[m * factor] = x[m], zero elsewhere
+     *
+     * Instead of stuffing zeros, h is split into `factor` phases, h_p[k] = h[k * factor + p], and
+     * output m * factor + p is \sum_k h_p[k]x[m - k]: every multiply lands on a real input sample,
+     * for M / factor multiply-adds per output instead of M.
+     *
+     * Like any zero-stuffing interpolator, the passband gain of h should be `factor` to keep the
+     * signal level unchanged.
+     * @tparam T The sample datatype. Must be float or double.
+     */
+    template<std::floating_point T>
+    class FirInterpolator
+    {
+    public:
+        /**
+         * @param h The anti-imaging filter. Must not be empty.
+         * @param factor The upsampling factor L. Must be positive.
+         */
+        FirInterpolator(std::span<const T> h, int factor)
+            : _factor(factor)
+        {
+            if (h.empty() || factor < 1)
+            {
+                throw std::invalid_argument("dsp::signals::FirInterpolator: need a non-empty filter and a positive factor");
+            }
+
+            // Phase p keeps taps p, p + L, p + 2L, ..., stored newest-last so each output is a dot product
+            _phaseLength = (static_cast<int>(h.size()) + factor - 1) / factor;
+            _phases.assign(static_cast<size_t>(factor) * _phaseLength, T(0));
+            _phaseTaps.resize(factor);
+            for (int p = 0; p < factor; ++p)
+            {
+                const int length = (static_cast<int>(h.size()) - p + factor - 1) / factor;
+                _phaseTaps[p] = length;
+                T* phase = _phases.data() + static_cast<size_t>(p) * _phaseLength;
+                for (int k = 0; k < length; ++k)
+                {
+                    phase[length - 1 - k] = h[static_cast<size_t>(k) * factor + p];
+                }
+            }
+
+            _window.resize(historyLength() + BLOCK_SIZE);
+            reset();
+        }
+
+        [[nodiscard]] int factor() const { return _factor; }
+
+        /**
+         * Clears the input history, as if the interpolator had only ever seen silence.
+         */
+        void reset()
+        {
+            std::fill(_window.begin(), _window.end(), T(0));
+        }
+
+        /**
+         * Filters `count` input samples into exactly count * factor() outputs. Never allocates.
+         */
+        void process(const T* input, int count, T* output)
+        {
+            const int history = historyLength();
+            while (count > 0)
+            {
+                const int chunk = std::min(count, BLOCK_SIZE);
+                std::copy_n(input, chunk, _window.begin() + history);
+
+                for (int r = 0; r < chunk; ++r)
+                {
+                    // Newest input sample for this group of outputs
+                    const T* newest = _window.data() + history + r;
+                    for (int p = 0; p < _factor; ++p)
+                    {
+                        const int length = _phaseTaps[p];
+                        *output++ = dotProduct(_phases.data() + static_cast<size_t>(p) * _phaseLength,
+                                               newest - length + 1, length);
+                    }
+                }
+
+                std::copy_n(_window.begin() + chunk, history, _window.begin());
+                input += chunk;
+                count -= chunk;
+            }
+        }
+
+    private:
+        static constexpr int BLOCK_SIZE = 1024;
+
+        [[nodiscard]] int historyLength() const { return _phaseLength - 1; }
+
+        int _factor;
+        int _phaseLength = 0;
+        std::vector<T> _phases;  // factor() rows of _phaseLength reversed taps
+        std::vector<int> _phaseTaps;
+        std::vector<T> _window; // [phase length - 1 samples of history][up to BLOCK_SIZE new samples]
+    };
+}
+
+#endif //SIGNAL_PROCESSING_BOOK_MULTIRATE_H
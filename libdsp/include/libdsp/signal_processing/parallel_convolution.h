@@ -0,0 +1,84 @@
+#ifndef SIGNAL_PROCESSING_BOOK_PARALLEL_CONVOLUTION_H
+#define SIGNAL_PROCESSING_BOOK_PARALLEL_CONVOLUTION_H
+
+#include "libdsp/platform/thread_pool.h"
+#include "libdsp/signal_processing/signal_processing.h"
+#include "libdsp/storage/buffer.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+
+namespace dsp::signals
+{
+    /**
+     * Number of output samples per task: enough that the input window a tile reads (tile + M - 1
+     * samples) and the outputs it writes stay in a per-core L2 cache for moderate M.
+     */
+    template<typename T>
+    constexpr int PARALLEL_CONVOLUTION_TILE = std::max<int>(1024, (64 * 1024) / sizeof(T));
+
+    /**
+     * Direct-form convolution with the output range split into cache-sized tiles that run on a
+     * ThreadPool. Each output sample only depends on the inputs, so the tiles are independent.
+     *
+     * Every output sample goes through the same convolveOutputSample as convolve1D, summing the same
+     * products in the same order, so the result is bit-identical to the serial path no matter how
+     * many threads run it.
+     * @param x The input signal (N samples)
+     * @param h The impulse response (M samples)
+     * @param y The output, N + M - 1 samples (none if `x` or `h` is empty). Must not overlap `x` or `h`.
+     * @param pool The threads to run on.
+     */
+    template<typename T>
+    void convolve1DParallel(std::span<const T> x, std::span<const T> h, std::span<T> y,
+                            platform::ThreadPool& pool = platform::ThreadPool::shared())
+    {
+        const ptrdiff_t n = static_cast<ptrdiff_t>(x.size());
+        const ptrdiff_t m = static_cast<ptrdiff_t>(h.size());
+        const ptrdiff_t outputLength = n == 0 || m == 0 ? 0 : n + m - 1;
+        if (static_cast<ptrdiff_t>(y.size()) != outputLength)
+        {
+            throw std::invalid_argument("dsp::signals::convolve1DParallel: output must hold N + M - 1 samples");
+        }
+        if (outputLength == 0)
+        {
+            return;
+        }
+
+        constexpr int tile = PARALLEL_CONVOLUTION_TILE<T>;
+        const int tileCount = static_cast<int>((outputLength + tile - 1) / tile);
+        pool.parallelFor(tileCount, 1, [&](int begin, int end) {
+            for (int t = begin; t < end; ++t)
+            {
+                const ptrdiff_t first = static_cast<ptrdiff_t>(t) * tile;
+                const ptrdiff_t last = std::min(outputLength, first + tile);
+                for (ptrdiff_t i = first; i < last; ++i)
+                {
+                    y[i] = convolveOutputSample(x.data(), n, h.data(), m, i);
+                }
+            }
+        });
+    }
+
+    /**
+     * convolve1D on libdsp buffers, with the output range split across a ThreadPool.
+     * Bit-identical to convolve1D.
+     * @tparam T The input signal datatype.
+     * @tparam InputSignalLength The length of the input signal in sample counts (N)
+     * @tparam ImpulseResponseLength The length of the impulse response in sample counts (M)
+     * @return The convolved output signal `y`
+     */
+    template<typename T, int InputSignalLength, int ImpulseResponseLength>
+    StaticBuffer<T, ImpulseResponseLength + InputSignalLength - 1>
+    convolve1DParallel(const StaticBuffer<T, InputSignalLength>& x, const StaticBuffer<T, ImpulseResponseLength>& h,
+                       platform::ThreadPool& pool = platform::ThreadPool::shared())
+    {
+        StaticBuffer<T, ImpulseResponseLength + InputSignalLength - 1> y;
+        convolve1DParallel<T>(x._data, h._data, y._data, pool);
+        return y;
+    }
+}
+
+#endif //SIGNAL_PROCESSING_BOOK_PARALLEL_CONVOLUTION_H
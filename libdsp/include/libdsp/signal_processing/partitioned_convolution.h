@@ -0,0 +1,314 @@
+#ifndef SIGNAL_PROCESSING_BOOK_PARTITIONED_CONVOLUTION_H
+#define SIGNAL_PROCESSING_BOOK_PARTITIONED_CONVOLUTION_H
+
+#include "libdsp/fft/plan_cache.h"
+#include "libdsp/signal_processing/fir_filter.h"
+
+#include <algorithm>
+#include <complex>
+#include <concepts>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace dsp::signals
+{
+    /**
+     * Streaming convolution with a uniformly partitioned impulse response (UPOLS).
+     *
+     * The impulse response is cut into P partitions of B samples and each partition's spectrum is
+     * precomputed. Every B input samples, the newest block is transformed once and pushed into a
+     * frequency-domain delay line (FDL) holding the spectra of the last P input blocks; the output
+     * block is the inverse FFT of sum_p X[block - p] * H[p], using overlap-save on 2B-point FFTs.
+     *
+     * This keeps the per-sample cost close to whole-signal FFT convolution while only ever needing
+     * one block of input, so it can run on a live stream. The output lags the input by exactly
+     * one block (B samples); input can be pushed in any chunk size.
+     * @tparam T The sample datatype. Must be float or double.
+     */
+    template<std::floating_point T>
+    class PartitionedConvolver
+    {
+    public:
+        /**
+         * @param h The impulse response.
+         * @param blockSize The partition size B, which is also the latency. 2B must be a valid FFT
+         *                  size (only prime factors 2, 3 and 5), e.g. 64, 128, 256.
+         */
+        PartitionedConvolver(std::span<const T> h, int blockSize)
+            : _blockSize(validated(blockSize)),
+              _partitionCount(std::max<int>(1, (static_cast<int>(h.size()) + blockSize - 1) / blockSize)),
+              _bins(blockSize + 1),
+              _forward(fft::PlanCache::instance().realPlan<T>(2 * blockSize, fft::Direction::Forward)),
+              _inverse(fft::PlanCache::instance().realPlan<T>(2 * blockSize, fft::Direction::Inverse))
+        {
+            _partitions.resize(static_cast<size_t>(_partitionCount) * _bins);
+            std::vector<T> padded(2 * _blockSize);
+            for (int p = 0; p < _partitionCount; ++p)
+            {
+                std::fill(padded.begin(), padded.end(), T(0));
+                const int first = p * _blockSize;
+                const int count = std::min<int>(_blockSize, static_cast<int>(h.size()) - first);
+                for (int i = 0; i < count; ++i)
+                {
+                    padded[i] = h[first + i];
+                }
+                _forward->execute(std::span<const T>(padded), partition(_partitions, p));
+            }
+
+            _delayLine.resize(_partitions.size());
+            _accumulator.resize(_bins);
+            _window.resize(2 * _blockSize);
+            _circular.resize(2 * _blockSize);
+            _outputBlock.resize(_blockSize);
+            reset();
+        }
+
+        [[nodiscard]] int blockSize() const { return _blockSize; }
+        [[nodiscard]] int partitionCount() const { return _partitionCount; }
+
+        /**
+         * @return The delay, in samples, between an input sample and its contribution to the output.
+         */
+        [[nodiscard]] int latency() const { return _blockSize; }
+
+        /**
+         * Clears the input history and delay line, as if the convolver had only ever seen silence.
+         */
+        void reset()
+        {
+            std::fill(_delayLine.begin(), _delayLine.end(), std::complex<T>{});
+            std::fill(_window.begin(), _window.end(), T(0));
+            std::fill(_outputBlock.begin(), _outputBlock.end(), T(0));
+            _fill = 0;
+            _head = 0;
+        }
+
+        /**
+         * Filters `count` samples. output[i] is the convolution output for input sample i - latency().
+         * Never allocates. `input` and `output` may point to the same buffer.
+         */
+        void process(const T* input, T* output, int count)
+        {
+            while (count > 0)
+            {
+                const int chunk = std::min(count, _blockSize - _fill);
+                // The newest block lives in the second half of the overlap-save window
+                std::copy_n(input, chunk, _window.begin() + _blockSize + _fill);
+                std::copy_n(_outputBlock.begin() + _fill, chunk, output);
+                _fill += chunk;
+                input += chunk;
+                output += chunk;
+                count -= chunk;
+
+                if (_fill == _blockSize)
+                {
+                    processBlock();
+                    _fill = 0;
+                }
+            }
+        }
+
+    private:
+        static int validated(int blockSize)
+        {
+            if (blockSize < 1)
+            {
+                throw std::invalid_argument("dsp::signals::PartitionedConvolver: block size must be positive");
+            }
+            return blockSize;
+        }
+
+        std::span<std::complex<T>> partition(std::vector<std::complex<T>>& spectra, int p) const
+        {
+            return std::span<std::complex<T>>(spectra.data() + static_cast<size_t>(p) * _bins, _bins);
+        }
+
+        void processBlock()
+        {
+            _forward->execute(std::span<const T>(_window), partition(_delayLine, _head));
+
+            // Y = sum_p X[newest - p] * H[p]
+            std::fill(_accumulator.begin(), _accumulator.end(), std::complex<T>{});
+            for (int p = 0; p < _partitionCount; ++p)
+            {
+                const int slot = (_head - p + _partitionCount) % _partitionCount;
+                const std::complex<T>* x = _delayLine.data() + static_cast<size_t>(slot) * _bins;
+                const std::complex<T>* h = _partitions.data() + static_cast<size_t>(p) * _bins;
+                for (int k = 0; k < _bins; ++k)
+                {
+                    _accumulator[k] += fft::detail::multiply(x[k], h[k]);
+                }
+            }
+
+            _inverse->execute(std::span<const std::complex<T>>(_accumulator), _circular);
+            // Overlap-save: the first B samples are wrapped around, the last B are valid
+            std::copy(_circular.begin() + _blockSize, _circular.end(), _outputBlock.begin());
+
+            // The newest block becomes the history half of the next window
+            std::copy(_window.begin() + _blockSize, _window.end(), _window.begin());
+
+            _head = (_head + 1) % _partitionCount;
+        }
+
+        int _blockSize;
+        int _partitionCount;
+        int _bins;
+        std::shared_ptr<const fft::RealPlan<T>> _forward;
+        std::shared_ptr<const fft::RealPlan<T>> _inverse;
+        std::vector<std::complex<T>> _partitions;
+        std::vector<std::complex<T>> _delayLine;
+        std::vector<std::complex<T>> _accumulator;
+        std::vector<T> _window;
+        std::vector<T> _outputBlock;
+        std::vector<T> _circular;
+        int _fill = 0;
+        int _head = 0;
+    };
+
+    /**
+     * Zero-latency streaming convolution with a non-uniformly partitioned impulse response.
+     *
+     * The first `headLength` taps run through a FirFilter, so output sample n already includes
+     * x[n] * h[0]. The rest of the impulse response is covered by PartitionedConvolvers with block
+     * sizes that double from segment to segment (B, 2B, 4B, ... up to `maxBlockSize`), each holding
+     * two partitions:
+     *
+     *   taps:   [0, B)   [B, 3B)     [3B, 7B)     [7B, 15B)   ...
+     *   block:  direct   B           2B           4B          ...
+     *
+     * A segment starting at tap S with block size Bs is at least Bs taps into the impulse response,
+     * so its one-block latency is hidden by feeding it the input delayed by S - Bs samples (padding
+     * its taps with zeros instead would cost it a third partition of mostly zeros). Early taps get
+     * short blocks (low latency, more work per sample), and the long tail gets large, efficient blocks.
+     * @tparam T The sample datatype. Must be float or double.
+     */
+    template<std::floating_point T>
+    class ZeroLatencyConvolver
+    {
+    public:
+        /**
+         * @param h The impulse response.
+         * @param headLength Number of leading taps computed in direct form. This is also the first
+         *                   FFT block size, so 2 * headLength must be a valid FFT size.
+         * @param maxBlockSize The largest FFT block size used for the tail; later taps all use it.
+         */
+        explicit ZeroLatencyConvolver(std::span<const T> h, int headLength = 64, int maxBlockSize = 8192)
+            : _head(validated(h, headLength, maxBlockSize).first(std::min<size_t>(h.size(), headLength)))
+        {
+            int start = headLength;
+            int blockSize = headLength;
+            const int length = static_cast<int>(h.size());
+            while (start < length)
+            {
+                const bool last = blockSize >= maxBlockSize;
+                const int end = last ? length : std::min(length, start + 2 * blockSize);
+                const int delay = start - blockSize;
+                _segments.push_back({PartitionedConvolver<T>(h.subspan(start, end - start), blockSize), std::vector<T>(delay, T(0))});
+
+                start = end;
+                blockSize = std::min(2 * blockSize, maxBlockSize);
+            }
+
+            _scratch.resize(SCRATCH_SIZE);
+            _delayed.resize(SCRATCH_SIZE);
+        }
+
+        /**
+         * @return Number of FFT-partitioned segments behind the direct-form head.
+         */
+        [[nodiscard]] int segmentCount() const { return static_cast<int>(_segments.size()); }
+
+        /**
+         * Clears all filter state, as if the convolver had only ever seen silence.
+         */
+        void reset()
+        {
+            _head.reset();
+            for (Segment& segment : _segments)
+            {
+                segment.convolver.reset();
+                std::fill(segment.delay.begin(), segment.delay.end(), T(0));
+                segment.position = 0;
+            }
+        }
+
+        /**
+         * Filters `count` samples with no added latency: output[i] = sum_j h[j] * input[i - j].
+         * Never allocates. `input` and `output` may not overlap.
+         */
+        void process(const T* input, T* output, int count)
+        {
+            _head.process(input, output, count);
+
+            for (int done = 0; done < count; done += SCRATCH_SIZE)
+            {
+                const int chunk = std::min(SCRATCH_SIZE, count - done);
+                for (Segment& segment : _segments)
+                {
+                    const T* source = input + done;
+                    if (!segment.delay.empty())
+                    {
+                        delayInput(segment, source, _delayed.data(), chunk);
+                        source = _delayed.data();
+                    }
+                    segment.convolver.process(source, _scratch.data(), chunk);
+                    for (int i = 0; i < chunk; ++i)
+                    {
+                        output[done + i] += _scratch[i];
+                    }
+                }
+            }
+        }
+
+    private:
+        static constexpr int SCRATCH_SIZE = 1024;
+
+        /**
+         * A PartitionedConvolver over taps [S, S + 2Bs) (or the rest of h), fed the input S - Bs
+         * samples late through a circular delay line.
+         */
+        struct Segment
+        {
+            PartitionedConvolver<T> convolver;
+            std::vector<T> delay; // the last delay.size() input samples, oldest at `position`
+            int position = 0;
+        };
+
+        /**
+         * Writes `count` input samples, delayed by the segment's delay line, to `delayed`.
+         */
+        static void delayInput(Segment& segment, const T* input, T* delayed, int count)
+        {
+            const int length = static_cast<int>(segment.delay.size());
+            while (count > 0)
+            {
+                const int run = std::min(count, length - segment.position);
+                T* slot = segment.delay.data() + segment.position;
+                std::copy_n(slot, run, delayed);
+                std::copy_n(input, run, slot);
+                segment.position = segment.position + run == length ? 0 : segment.position + run;
+                input += run;
+                delayed += run;
+                count -= run;
+            }
+        }
+
+        static std::span<const T> validated(std::span<const T> h, int headLength, int maxBlockSize)
+        {
+            if (h.empty() || headLength < 1 || maxBlockSize < headLength)
+            {
+                throw std::invalid_argument("dsp::signals::ZeroLatencyConvolver: need a non-empty impulse response and 1 <= headLength <= maxBlockSize");
+            }
+            return h;
+        }
+
+        FirFilter<T> _head;
+        std::vector<Segment> _segments;
+        std::vector<T> _scratch;
+        std::vector<T> _delayed;
+    };
+}
+
+#endif //SIGNAL_PROCESSING_BOOK_PARTITIONED_CONVOLUTION_H
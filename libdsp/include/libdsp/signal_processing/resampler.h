@@ -0,0 +1,250 @@
+#ifndef SIGNAL_PROCESSING_BOOK_RESAMPLER_H
+#define SIGNAL_PROCESSING_BOOK_RESAMPLER_H
+
+#include "libdsp/signal_processing/direct_convolution.h"
+#include "libdsp/signal_processing/windows.h"
+#include "libdsp/storage/buffer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace dsp::signals
+{
+    /**
+     * Quality knobs for Resampler's windowed-sinc lowpass.
+     */
+    struct ResamplerSettings
+    {
+        /** Zero crossings of the sinc kept on each side of the center. More is sharper and slower. */
+        int zeroCrossings = 16;
+        /** Passband edge as a fraction of the lower of the two Nyquist frequencies. */
+        double cutoff = 0.92;
+        /** Kaiser window shape; ~9 gives roughly 90 dB of stopband attenuation. */
+        double kaiserBeta = 9.0;
+        /** Largest up factor L handled exactly as a rational L / M ratio. */
+        int maxRationalPhases = 1024;
+        /** Table rows used for ratios that are not (small) rationals; phases in between are interpolated. */
+        int interpolatedPhases = 512;
+    };
+
+    /**
+     * Streaming sample-rate converter with precomputed polyphase windowed-sinc tables.
+     *
+     * Output sample n is the input signal band-limited and evaluated at input time t = n * in / out:
+     *   y[n] = \sum_i x[i] h(t - i),  h(t) = 2fc sinc(2fc t) kaiser(t / halfWidth)
+     * with fc the cutoff in cycles per input sample. Each distinct fractional part of t needs its
+     * own set of K taps (a phase), which are precomputed in a table and applied with dotProduct:
+     *  - Rational ratios (both rates integers, e.g. 44100 -> 48000 = 160 / 147) have exactly L
+     *    distinct phases, so the table holds all of them and every output is one exact dot product.
+     *  - Any other ratio uses a table of `interpolatedPhases` rows; each output takes the dot products
+     *    with the two neighbouring rows and linearly interpolates between them.
+     *
+     * The filter is centered on t, so outputs need K / 2 input samples past t (latency()); the
+     * samples before the stream starts are treated as zeros.
+     * @tparam T The sample datatype. Must be float or double.
+     */
+    template<std::floating_point T>
+    class Resampler
+    {
+    public:
+        /**
+         * @param inputRate Sample rate of the input, in any unit.
+         * @param outputRate Sample rate of the output, in the same unit.
+         */
+        Resampler(double inputRate, double outputRate, const ResamplerSettings& settings = {})
+        {
+            if (!(inputRate > 0.0) || !(outputRate > 0.0) || settings.zeroCrossings < 1 ||
+                settings.interpolatedPhases < 1 || !(settings.cutoff > 0.0 && settings.cutoff <= 1.0))
+            {
+                throw std::invalid_argument("dsp::signals::Resampler: rates must be positive and settings in range");
+            }
+
+            _step = inputRate / outputRate;
+            if (std::floor(inputRate) == inputRate && std::floor(outputRate) == outputRate &&
+                inputRate < 2147483647.0 && outputRate < 2147483647.0)
+            {
+                const long long in = static_cast<long long>(inputRate);
+                const long long out = static_cast<long long>(outputRate);
+                const long long divisor = std::gcd(in, out);
+                if (out / divisor <= settings.maxRationalPhases)
+                {
+                    _rational = true;
+                    _up = static_cast<int>(out / divisor);
+                    _down = static_cast<int>(in / divisor);
+                }
+            }
+            _phaseCount = _rational ? _up : settings.interpolatedPhases;
+
+            // Downsampling moves the cutoff below the output Nyquist, which widens the kernel in input samples
+            const double fc = 0.5 * settings.cutoff * std::min(1.0, outputRate / inputRate);
+            const double halfWidth = settings.zeroCrossings / (2.0 * fc);
+            _taps = 2 * static_cast<int>(std::ceil(halfWidth));
+
+            // Row p holds the taps for fractional time p / phaseCount, applied to
+            // x[n0 - K/2 + 1, n0 + K/2]; the extra last row (fraction 1) is only read when interpolating
+            const int rows = _phaseCount + 1;
+            _table.resize(static_cast<size_t>(rows) * _taps);
+            for (int p = 0; p < rows; ++p)
+            {
+                const double fraction = static_cast<double>(p) / _phaseCount;
+                T* row = _table.data() + static_cast<size_t>(p) * _taps;
+                for (int k = 0; k < _taps; ++k)
+                {
+                    const double t = fraction + _taps / 2 - 1 - k;
+                    row[k] = static_cast<T>(2.0 * fc * sinc(2.0 * fc * t) * kaiserWindow(t / halfWidth, settings.kaiserBeta));
+                }
+            }
+
+            _window.resize(_taps + BLOCK_SIZE);
+            reset();
+        }
+
+        /**
+         * @return True if the ratio is handled exactly as up() / down() rather than interpolated.
+         */
+        [[nodiscard]] bool isRational() const { return _rational; }
+        [[nodiscard]] int up() const { return _up; }
+        [[nodiscard]] int down() const { return _down; }
+
+        /**
+         * @return Filter length K in input samples.
+         */
+        [[nodiscard]] int taps() const { return _taps; }
+
+        /**
+         * @return How many input samples past an output's time must arrive before it is produced.
+         */
+        [[nodiscard]] int latency() const { return _taps / 2; }
+
+        /**
+         * @return The most outputs a call to process() with `inputCount` samples can produce.
+         */
+        [[nodiscard]] int maxOutputCount(int inputCount) const
+        {
+            return static_cast<int>(std::floor(inputCount / _step)) + 2;
+        }
+
+        /**
+         * Clears the input history and restarts output time at the next input sample.
+         */
+        void reset()
+        {
+            std::fill(_window.begin(), _window.end(), T(0));
+            // x[-K/2 + 1, 0) are the zeros in front of the stream
+            _fill = _taps / 2 - 1;
+            _next = 0;
+            _phase = 0;
+            _fraction = 0.0;
+        }
+
+        /**
+         * Resamples `count` input samples, writing every output whose inputs are now all available.
+         * Never allocates.
+         * @param output Room for at least maxOutputCount(count) samples.
+         * @return The number of outputs written.
+         */
+        int process(const T* input, int count, T* output)
+        {
+            int written = 0;
+            while (count > 0)
+            {
+                const int chunk = std::min(count, static_cast<int>(_window.size()) - _fill);
+                std::copy_n(input, chunk, _window.begin() + _fill);
+                _fill += chunk;
+                input += chunk;
+                count -= chunk;
+
+                while (_next + _taps <= _fill)
+                {
+                    output[written++] = _rational ? nextRational() : nextInterpolated();
+                }
+
+                // Drop the samples no future output can reach
+                std::copy(_window.begin() + _next, _window.begin() + _fill, _window.begin());
+                _fill -= _next;
+                _next = 0;
+            }
+            return written;
+        }
+
+    private:
+        static constexpr int BLOCK_SIZE = 1024;
+
+        const T* row(int p) const
+        {
+            return _table.data() + static_cast<size_t>(p) * _taps;
+        }
+
+        T nextRational()
+        {
+            const T y = dotProduct(row(_phase), _window.data() + _next, _taps);
+            _phase += _down;
+            _next += _phase / _up;
+            _phase %= _up;
+            return y;
+        }
+
+        T nextInterpolated()
+        {
+            const double position = _fraction * _phaseCount;
+            const int p = std::min(static_cast<int>(position), _phaseCount - 1);
+            const T mix = static_cast<T>(position - p);
+            const T* x = _window.data() + _next;
+            const T lower = dotProduct(row(p), x, _taps);
+            const T upper = dotProduct(row(p + 1), x, _taps);
+
+            _fraction += _step;
+            const double whole = std::floor(_fraction);
+            _fraction -= whole;
+            _next += static_cast<int>(whole);
+            return lower + mix * (upper - lower);
+        }
+
+        double _step = 1.0;
+        bool _rational = false;
+        int _up = 0;
+        int _down = 0;
+        int _phaseCount = 1;
+        int _taps = 0;
+        std::vector<T> _table;
+        std::vector<T> _window; // Input samples from the oldest one the next output can reach
+        int _fill = 0;          // Valid samples in _window
+        int _next = 0;          // First window sample under the next output's taps
+        int _phase = 0;         // Rational: fractional time of the next output, in units of 1 / up()
+        double _fraction = 0.0; // Interpolated: fractional time of the next output
+    };
+
+    /**
+     * Resamples a whole libdsp buffer by the rational factor Up / Down. Output n is the band-limited
+     * input at time n * Down / Up, with zeros assumed before and after the buffer.
+     * @tparam Up The interpolation factor L.
+     * @tparam Down The decimation factor M.
+     * @tparam T The sample datatype. Must be float or double.
+     * @tparam N The input length; the output has ceil(N * Up / Down) samples.
+     */
+    template<int Up, int Down, std::floating_point T, int N>
+    StaticBuffer<T, (N * Up + Down - 1) / Down> resample(const StaticBuffer<T, N>& x, const ResamplerSettings& settings = {})
+    {
+        static_assert(Up > 0 && Down > 0, "Resampling factors must be positive");
+        constexpr int outputLength = (N * Up + Down - 1) / Down;
+
+        ResamplerSettings exact = settings;
+        exact.maxRationalPhases = std::max(exact.maxRationalPhases, Up);
+        Resampler<T> resampler(Down, Up, exact);
+
+        std::vector<T> output(resampler.maxOutputCount(N) + resampler.maxOutputCount(resampler.latency()));
+        int written = resampler.process(x._data.data(), N, output.data());
+        const std::vector<T> silence(resampler.latency(), T(0));
+        resampler.process(silence.data(), static_cast<int>(silence.size()), output.data() + written);
+
+        StaticBuffer<T, outputLength> y;
+        std::copy_n(output.begin(), outputLength, y._data.begin());
+        return y;
+    }
+}
+
+#endif //SIGNAL_PROCESSING_BOOK_RESAMPLER_H
@@ -3,12 +3,83 @@
 
 #include "libdsp/storage/buffer.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <utility>
+
 namespace dsp::signals
 {
+    /**
+     * Which part of a convolution (or correlation) to return, for signal length N and kernel length M:
+     *  - Full: every output with any overlap, N + M - 1 samples (what convolve1D returns)
+     *  - Same: the centered N samples, starting (M - 1) / 2 samples into the full output
+     *  - Valid: only outputs where the kernel fully overlaps the signal, N - M + 1 samples
+     */
+    enum class ConvolutionRegion
+    {
+        Full,
+        Same,
+        Valid
+    };
+
+    /**
+     * @return The {offset into the full output, length} of `region`, for signal length n and kernel length m.
+     */
+    constexpr std::pair<int, int> regionBounds(ConvolutionRegion region, int n, int m)
+    {
+        switch (region)
+        {
+            case ConvolutionRegion::Same: return {(m - 1) / 2, n};
+            case ConvolutionRegion::Valid: return {m - 1, std::max(0, n - m + 1)};
+            default: return {0, n + m - 1};
+        }
+    }
+
+    /**
+     * One output sample of the output-side convolution algorithm:
+     *   y[i] = \sum_{j=0}{M - 1} h[j]x[i - j]
+     * Only visits the taps for which 0 <= i - j < N, in ascending order. Every direct-form path that
+     * promises results identical to convolve1D goes through this, so they round the same way.
+     * @param x The input signal (N samples)
+     * @param h The impulse response (M samples)
+     */
+    template<typename T>
+    T convolveOutputSample(const T* x, ptrdiff_t n, const T* h, ptrdiff_t m, ptrdiff_t i)
+    {
+        const ptrdiff_t jBegin = std::max<ptrdiff_t>(0, i - n + 1);
+        const ptrdiff_t jEnd = std::min(m, i + 1);
+        T response = 0;
+        for (ptrdiff_t j = jBegin; j < jEnd; ++j)
+        {
+            response += h[j] * x[i - j];
+        }
+        return response;
+    }
+
+    namespace detail
+    {
+        /**
+         * dest[t] = row[first + t] for t in [0, length), with zeros wherever first + t falls outside the row.
+         */
+        template<typename T>
+        void copyPadded(std::span<const T> row, int first, int length, T* dest)
+        {
+            const int size = static_cast<int>(row.size());
+            for (int t = 0; t < length; ++t)
+            {
+                const int column = first + t;
+                dest[t] = column >= 0 && column < size ? row[column] : T(0);
+            }
+        }
+    }
+
     /**
      * Implements a 1D convolution against the input buffer using the output-side algorithm:
      *   y[i] = \sum_{j=0}{M - 1} h[j]x[i - j]
      * Given an input signal `x` of N samples and an impulse response `h` of M samples.
+     * Sums are accumulated in T itself, so integer samples can overflow; for Q15 / Q31 fixed-point
+     * data use convolve1DQ15 / convolve1DQ31 (fixed_point_convolution.h), which round and saturate.
      * @tparam T The input signal datatype.
      * @tparam InputSignalLength The length of the input signal in sample counts (N)
      * @tparam ImpulseResponseLength The length of the impulse response in sample counts (M)
@@ -25,16 +96,7 @@ namespace dsp::signals
 
         for (int i = 0; i < outputLength; ++i)
         {
-            T response = 0;
-            for (int j = 0; j < ImpulseResponseLength; ++j)
-            {
-                if (i - j >= 0 &&
-                    i - j < InputSignalLength)
-                {
-                    response += h[j] * x[i - j];
-                }
-            }
-            y[i] = response;
+            y[i] = convolveOutputSample(x._data.data(), InputSignalLength, h._data.data(), ImpulseResponseLength, i);
         }
 
         return y;
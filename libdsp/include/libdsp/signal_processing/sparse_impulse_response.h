@@ -0,0 +1,185 @@
+#ifndef SIGNAL_PROCESSING_BOOK_SPARSE_IMPULSE_RESPONSE_H
+#define SIGNAL_PROCESSING_BOOK_SPARSE_IMPULSE_RESPONSE_H
+
+#include "libdsp/fft/plan_cache.h"
+#include "libdsp/signal_processing/direct_convolution.h"
+#include "libdsp/signal_processing/signal_processing.h"
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace dsp::signals
+{
+    namespace detail
+    {
+        // A sparse tap reads and writes its outputs (the direct-form kernels keep them in
+        // registers), so it costs about this many dense taps
+        constexpr double SPARSE_TAP_COST = 2.0;
+
+        // Per output and per log2 of the transform size, the cost of overlap-save FFT convolution in
+        // vectorized dense taps. Measured at 120 - 140 on AVX2, and rounded down to stay conservative
+        constexpr double FFT_TAP_COST_PER_LOG2 = 100.0;
+
+        /**
+         * @return True if convolving with `taps` non-zero taps spread over `length` samples is
+         *         cheaper one tap at a time than with the dense vectorized direct form, or than
+         *         FFT convolution, whichever of the two is cheaper.
+         */
+        inline bool sparseBeatsDense(int taps, int length)
+        {
+            const int fftSize = fft::nextPowerOfTwo(std::max(16, 4 * length));
+            const double fftCost = FFT_TAP_COST_PER_LOG2 * std::log2(fftSize) * fftSize / (fftSize - length + 1);
+            return SPARSE_TAP_COST * taps < std::min<double>(length, fftCost);
+        }
+
+        /**
+         * @return True if `h` has few enough non-zero taps for sparseBeatsDense.
+         */
+        template<std::floating_point T>
+        bool preferSparse(std::span<const T> h)
+        {
+            const auto taps = std::count_if(h.begin(), h.end(), [](T tap) { return tap != T(0); });
+            return taps > 0 && sparseBeatsDense(static_cast<int>(taps), static_cast<int>(h.size()));
+        }
+    }
+
+    /**
+     * An impulse response stored as (offset, gain) pairs, for responses that are mostly zero:
+     * echoes and multipath models with a handful of taps spread over thousands of samples, or a
+     * dense response with leading zeros (a delay). Convolution costs one vectorized multiply-add
+     * per output per non-zero tap, independent of how long the response is, where the direct form
+     * pays for every zero and FFT convolution for the full length.
+     *
+     * beatsDense() says whether that is actually cheaper than the dense strategies;
+     * convolve() in convolution_planner.h makes the same check on every impulse response it gets.
+     * @tparam T The sample datatype. Must be float or double.
+     */
+    template<std::floating_point T>
+    class SparseImpulseResponse
+    {
+    public:
+        SparseImpulseResponse() = default;
+
+        /**
+         * Keeps the taps of a dense impulse response with |h[j]| > threshold.
+         */
+        explicit SparseImpulseResponse(std::span<const T> h, T threshold = T(0))
+        {
+            for (int j = 0; j < static_cast<int>(h.size()); ++j)
+            {
+                if (std::abs(h[j]) > threshold)
+                {
+                    _offsets.push_back(j);
+                    _gains.push_back(h[j]);
+                }
+            }
+        }
+
+        /**
+         * @param offsets The tap positions, in any order. Must be non-negative.
+         * @param gains One gain per offset. Gains at a repeated offset add up.
+         */
+        SparseImpulseResponse(std::span<const int> offsets, std::span<const T> gains)
+        {
+            if (offsets.size() != gains.size())
+            {
+                throw std::invalid_argument("dsp::signals::SparseImpulseResponse: need one gain per offset");
+            }
+            for (std::size_t t = 0; t < offsets.size(); ++t)
+            {
+                addTap(offsets[t], gains[t]);
+            }
+        }
+
+        /**
+         * Adds `gain` to the tap at `offset`, creating it if needed.
+         * @param offset Must be non-negative.
+         */
+        void addTap(int offset, T gain)
+        {
+            if (offset < 0)
+            {
+                throw std::invalid_argument("dsp::signals::SparseImpulseResponse: tap offsets must be non-negative");
+            }
+            const auto position = std::lower_bound(_offsets.begin(), _offsets.end(), offset);
+            const auto index = position - _offsets.begin();
+            if (position != _offsets.end() && *position == offset)
+            {
+                _gains[index] += gain;
+                return;
+            }
+            _offsets.insert(position, offset);
+            _gains.insert(_gains.begin() + index, gain);
+        }
+
+        [[nodiscard]] int tapCount() const { return static_cast<int>(_offsets.size()); }
+
+        /**
+         * @return The length of the equivalent dense response: the last offset + 1, or 0 with no taps.
+         */
+        [[nodiscard]] int length() const { return _offsets.empty() ? 0 : _offsets.back() + 1; }
+
+        [[nodiscard]] std::span<const int> offsets() const { return _offsets; }
+        [[nodiscard]] std::span<const T> gains() const { return _gains; }
+
+        /**
+         * @return The equivalent dense impulse response, length() samples.
+         */
+        [[nodiscard]] std::vector<T> toDense() const
+        {
+            std::vector<T> h(length(), T(0));
+            for (int t = 0; t < tapCount(); ++t)
+            {
+                h[_offsets[t]] = _gains[t];
+            }
+            return h;
+        }
+
+        /**
+         * @return True if convolving with the taps one at a time is expected to beat the dense
+         *         direct form and FFT convolution of the length() sample equivalent.
+         */
+        [[nodiscard]] bool beatsDense() const
+        {
+            return !_offsets.empty() && detail::sparseBeatsDense(tapCount(), length());
+        }
+
+        /**
+         * Full linear convolution with `x` (n samples), the same as convolve1D with toDense().
+         * @param y Output buffer of n + length() - 1 samples. Must not overlap `x`.
+         */
+        void convolve(const T* x, int n, T* y) const
+        {
+            if (n > 0 && !_offsets.empty())
+            {
+                convolveSparse(x, n, _offsets.data(), _gains.data(), tapCount(), y, 0, n + length() - 1);
+            }
+        }
+
+        /**
+         * Convolution with `x`, computing only the outputs in `region`.
+         */
+        [[nodiscard]] std::vector<T> convolve(std::span<const T> x, ConvolutionRegion region = ConvolutionRegion::Full) const
+        {
+            const int n = static_cast<int>(x.size());
+            if (n == 0 || _offsets.empty())
+            {
+                return {};
+            }
+            const auto [offset, count] = regionBounds(region, n, length());
+            std::vector<T> y(count);
+            convolveSparse(x.data(), n, _offsets.data(), _gains.data(), tapCount(), y.data(), offset, count);
+            return y;
+        }
+
+    private:
+        std::vector<int> _offsets; // ascending
+        std::vector<T> _gains;
+    };
+}
+
+#endif //SIGNAL_PROCESSING_BOOK_SPARSE_IMPULSE_RESPONSE_H
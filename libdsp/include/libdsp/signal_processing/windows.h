@@ -0,0 +1,62 @@
+#ifndef SIGNAL_PROCESSING_BOOK_WINDOWS_H
+#define SIGNAL_PROCESSING_BOOK_WINDOWS_H
+
+#include <cmath>
+#include <numbers>
+
+namespace dsp::signals
+{
+    /**
+     * Zeroth-order modified Bessel function of the first kind, from its power series
+     *   I0(x) = \sum_{k=0}^{inf} ((x / 2)^k / k!)^2
+     * The terms shrink quickly for the beta values windows use (< 20), so the sum stops once a
+     * term no longer changes the result.
+     */
+    inline double besselI0(double x)
+    {
+        const double halfX = x / 2.0;
+        double term = 1.0;
+        double sum = 1.0;
+        for (int k = 1; k < 500; ++k)
+        {
+            term *= (halfX / k) * (halfX / k);
+            sum += term;
+            if (term < sum * 1e-17)
+            {
+                break;
+            }
+        }
+        return sum;
+    }
+
+    /**
+     * Kaiser window evaluated at a normalized position u in [-1, 1] (0 is the center):
+     *   w(u) = I0(beta * sqrt(1 - u^2)) / I0(beta)
+     * Larger beta trades a wider main lobe for lower sidelobes; beta ~ 0.1102 * (A - 8.7) gives
+     * roughly A dB of stopband attenuation when used to design a lowpass filter.
+     * @return The window value, or 0 outside [-1, 1].
+     */
+    inline double kaiserWindow(double u, double beta)
+    {
+        if (u < -1.0 || u > 1.0)
+        {
+            return 0.0;
+        }
+        return besselI0(beta * std::sqrt(1.0 - u * u)) / besselI0(beta);
+    }
+
+    /**
+     * Normalized sinc: sin(pi x) / (pi x), with sinc(0) = 1.
+     */
+    inline double sinc(double x)
+    {
+        if (std::abs(x) < 1e-12)
+        {
+            return 1.0;
+        }
+        const double px = std::numbers::pi * x;
+        return std::sin(px) / px;
+    }
+}
+
+#endif //SIGNAL_PROCESSING_BOOK_WINDOWS_H
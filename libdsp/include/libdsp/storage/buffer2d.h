@@ -0,0 +1,69 @@
+#ifndef SIGNAL_PROCESSING_BOOK_BUFFER2D_H
+#define SIGNAL_PROCESSING_BOOK_BUFFER2D_H
+
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace dsp
+{
+    /***
+     * Heap-backed 2D buffer (e.g. an image or camera frame), stored row-major.
+     * Unlike StaticBuffer the dimensions are chosen at runtime, since frames are usually far
+     * too large to live on the stack and their size often comes from a device.
+     */
+    template<typename T>
+    class Buffer2D
+    {
+    public:
+        std::vector<T> _data;
+
+        Buffer2D() = default;
+
+        Buffer2D(int rows, int columns, T value = T(0))
+            : _data(checkedSize(rows, columns), value), _rows(rows), _columns(columns)
+        {
+        }
+
+        [[nodiscard]] int rows() const { return _rows; }
+        [[nodiscard]] int columns() const { return _columns; }
+        [[nodiscard]] size_t size() const { return _data.size(); }
+        [[nodiscard]] bool empty() const { return _data.empty(); }
+
+        T& operator()(int row, int column)
+        {
+            return _data[static_cast<size_t>(row) * _columns + column];
+        }
+
+        const T& operator()(int row, int column) const
+        {
+            return _data[static_cast<size_t>(row) * _columns + column];
+        }
+
+        std::span<T> row(int row)
+        {
+            return std::span<T>(_data.data() + static_cast<size_t>(row) * _columns, _columns);
+        }
+
+        std::span<const T> row(int row) const
+        {
+            return std::span<const T>(_data.data() + static_cast<size_t>(row) * _columns, _columns);
+        }
+
+    private:
+        static size_t checkedSize(int rows, int columns)
+        {
+            if (rows < 0 || columns < 0)
+            {
+                throw std::invalid_argument("dsp::Buffer2D: dimensions must not be negative");
+            }
+            return static_cast<size_t>(rows) * columns;
+        }
+
+        int _rows = 0;
+        int _columns = 0;
+    };
+}
+
+#endif //SIGNAL_PROCESSING_BOOK_BUFFER2D_H
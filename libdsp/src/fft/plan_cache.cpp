@@ -0,0 +1,194 @@
+#include "libdsp/fft/plan_cache.h"
+
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+
+namespace dsp::fft
+{
+    namespace
+    {
+        constexpr const char* WISDOM_HEADER = "dsp-fft-wisdom";
+        constexpr int WISDOM_VERSION = 1;
+
+        template<std::floating_point T>
+        constexpr Precision precisionOf()
+        {
+            return std::is_same_v<T, float> ? Precision::Single : Precision::Double;
+        }
+    }
+
+    PlanCache& PlanCache::instance()
+    {
+        static PlanCache cache;
+        return cache;
+    }
+
+    template<typename PlanT>
+    std::shared_ptr<const PlanT> PlanCache::lookupOrInsert(const Key& key, const std::function<std::shared_ptr<const PlanT>()>& build)
+    {
+        {
+            std::shared_lock lock(_mutex);
+            auto it = _plans.find(key);
+            if (it != _plans.end())
+            {
+                return std::get<std::shared_ptr<const PlanT>>(it->second);
+            }
+        }
+
+        // Plan setup can be expensive for large sizes; don't hold the lock while doing it.
+        // If another thread raced us to the same key, keep the plan that was published first.
+        auto plan = build();
+        std::unique_lock lock(_mutex);
+        auto [it, inserted] = _plans.try_emplace(key, plan);
+        return std::get<std::shared_ptr<const PlanT>>(it->second);
+    }
+
+    template<std::floating_point T>
+    std::shared_ptr<const Plan<T>> PlanCache::complexPlan(int size, Direction direction)
+    {
+        return lookupOrInsert<Plan<T>>({size, TransformType::Complex, direction, precisionOf<T>()}, [&]() {
+            return std::make_shared<const Plan<T>>(size, direction);
+        });
+    }
+
+    template<std::floating_point T>
+    std::shared_ptr<const RealPlan<T>> PlanCache::realPlan(int size, Direction direction)
+    {
+        return lookupOrInsert<RealPlan<T>>({size, TransformType::Real, direction, precisionOf<T>()}, [&]() {
+            return std::make_shared<const RealPlan<T>>(size, direction);
+        });
+    }
+
+    template std::shared_ptr<const Plan<float>> PlanCache::complexPlan<float>(int, Direction);
+    template std::shared_ptr<const Plan<double>> PlanCache::complexPlan<double>(int, Direction);
+    template std::shared_ptr<const RealPlan<float>> PlanCache::realPlan<float>(int, Direction);
+    template std::shared_ptr<const RealPlan<double>> PlanCache::realPlan<double>(int, Direction);
+
+    /**
+     * Wisdom is a small text file: a header line followed by one line per plan,
+     *   <f32|f64> <complex|real> <forward|inverse> <size> <radix> <radix> ...
+     * Only the stage layout is stored; twiddles and permutations are cheap to regenerate from it.
+     */
+    bool PlanCache::saveWisdom(const std::string& path) const
+    {
+        std::ofstream file(path);
+        if (!file)
+        {
+            return false;
+        }
+
+        file << WISDOM_HEADER << " " << WISDOM_VERSION << "\n";
+
+        std::shared_lock lock(_mutex);
+        for (const auto& [key, entry] : _plans)
+        {
+            file << (key.precision == Precision::Single ? "f32" : "f64") << " "
+                 << (key.type == TransformType::Complex ? "complex" : "real") << " "
+                 << (key.direction == Direction::Forward ? "forward" : "inverse") << " "
+                 << key.size;
+            std::visit([&file](const auto& plan) {
+                for (int radix : plan->radices())
+                {
+                    file << " " << radix;
+                }
+            }, entry);
+            file << "\n";
+        }
+        return static_cast<bool>(file);
+    }
+
+    bool PlanCache::loadWisdom(const std::string& path)
+    {
+        std::ifstream file(path);
+        if (!file)
+        {
+            return false;
+        }
+
+        std::string header;
+        int version = 0;
+        if (!(file >> header >> version) || header != WISDOM_HEADER || version != WISDOM_VERSION)
+        {
+            return false;
+        }
+
+        bool allValid = true;
+        std::string line;
+        std::getline(file, line); // Rest of the header line
+        while (std::getline(file, line))
+        {
+            if (line.empty())
+            {
+                continue;
+            }
+
+            std::istringstream fields(line);
+            std::string precision, type, direction;
+            int size = 0;
+            if (!(fields >> precision >> type >> direction >> size))
+            {
+                allValid = false;
+                continue;
+            }
+            std::vector<int> radices;
+            for (int radix; fields >> radix;)
+            {
+                radices.push_back(radix);
+            }
+
+            const bool validKey = (precision == "f32" || precision == "f64") &&
+                                  (type == "complex" || type == "real") &&
+                                  (direction == "forward" || direction == "inverse");
+            if (!validKey)
+            {
+                allValid = false;
+                continue;
+            }
+
+            const Key key{size,
+                          type == "complex" ? TransformType::Complex : TransformType::Real,
+                          direction == "forward" ? Direction::Forward : Direction::Inverse,
+                          precision == "f32" ? Precision::Single : Precision::Double};
+            try
+            {
+                if (key.type == TransformType::Complex && key.precision == Precision::Single)
+                {
+                    lookupOrInsert<Plan<float>>(key, [&]() { return std::make_shared<const Plan<float>>(size, key.direction, radices); });
+                }
+                else if (key.type == TransformType::Complex)
+                {
+                    lookupOrInsert<Plan<double>>(key, [&]() { return std::make_shared<const Plan<double>>(size, key.direction, radices); });
+                }
+                else if (key.precision == Precision::Single)
+                {
+                    lookupOrInsert<RealPlan<float>>(key, [&]() { return std::make_shared<const RealPlan<float>>(size, key.direction, radices); });
+                }
+                else
+                {
+                    lookupOrInsert<RealPlan<double>>(key, [&]() { return std::make_shared<const RealPlan<double>>(size, key.direction, radices); });
+                }
+            }
+            catch (const std::exception&)
+            {
+                // Stale or hand-edited wisdom with an impossible stage layout
+                allValid = false;
+            }
+        }
+        return allValid;
+    }
+
+    size_t PlanCache::size() const
+    {
+        std::shared_lock lock(_mutex);
+        return _plans.size();
+    }
+
+    void PlanCache::clear()
+    {
+        std::unique_lock lock(_mutex);
+        _plans.clear();
+    }
+}
@@ -0,0 +1,85 @@
+#include "libdsp/platform/cpu_features.h"
+
+#include <initializer_list>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+namespace dsp::platform
+{
+    namespace
+    {
+        CpuFeatures detect()
+        {
+            CpuFeatures features;
+#if defined(__x86_64__) || defined(__i386__)
+            // libgcc/compiler-rt also check that the OS saves the AVX/AVX-512 register state
+            __builtin_cpu_init();
+            features.sse2 = __builtin_cpu_supports("sse2");
+            features.avx2 = __builtin_cpu_supports("avx2");
+            features.fma = __builtin_cpu_supports("fma");
+            features.avx512f = __builtin_cpu_supports("avx512f");
+            features.avx512bw = __builtin_cpu_supports("avx512bw");
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+            int info[4] = {};
+            __cpuid(info, 0);
+            const int maxLeaf = info[0];
+
+            __cpuid(info, 1);
+            features.sse2 = (info[3] & (1 << 26)) != 0;
+            features.fma = (info[2] & (1 << 12)) != 0;
+            const bool osSavesState = (info[2] & (1 << 27)) != 0; // OSXSAVE
+            const unsigned long long xcr0 = osSavesState ? _xgetbv(0) : 0;
+            const bool osAvx = (xcr0 & 0x6) == 0x6;       // XMM and YMM state
+            const bool osAvx512 = (xcr0 & 0xE6) == 0xE6;  // plus opmask and ZMM state
+            features.fma = features.fma && osAvx;
+
+            if (maxLeaf >= 7)
+            {
+                __cpuidex(info, 7, 0);
+                features.avx2 = osAvx && (info[1] & (1 << 5)) != 0;
+                features.avx512f = osAvx512 && (info[1] & (1 << 16)) != 0;
+                features.avx512bw = osAvx512 && (info[1] & (1 << 30)) != 0;
+            }
+#elif defined(__aarch64__) || defined(_M_ARM64)
+            // Advanced SIMD is mandatory on AArch64
+            features.neon = true;
+#endif
+            return features;
+        }
+    }
+
+    const CpuFeatures& cpuFeatures()
+    {
+        static const CpuFeatures features = detect();
+        return features;
+    }
+
+    bool isSupported(SimdLevel level)
+    {
+        const CpuFeatures& features = cpuFeatures();
+        switch (level)
+        {
+            case SimdLevel::Scalar: return true;
+            case SimdLevel::SSE2: return features.sse2;
+            case SimdLevel::AVX2: return features.avx2 && features.fma;
+            case SimdLevel::AVX512: return features.avx512f;
+            case SimdLevel::NEON: return features.neon;
+        }
+        return false;
+    }
+
+    SimdLevel bestSimdLevel()
+    {
+        for (SimdLevel level : {SimdLevel::AVX512, SimdLevel::AVX2, SimdLevel::SSE2, SimdLevel::NEON})
+        {
+            if (isSupported(level))
+            {
+                return level;
+            }
+        }
+        return SimdLevel::Scalar;
+    }
+}
@@ -0,0 +1,158 @@
+#include "libdsp/platform/thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+namespace dsp::platform
+{
+    struct ThreadPool::Job
+    {
+        int count;
+        int grain;
+        int chunks;
+        const std::function<void(int, int)>* fn;
+        std::atomic<int> nextChunk{0};
+        std::atomic<int> remainingChunks;
+        std::mutex mutex;
+        std::condition_variable finished;
+        std::exception_ptr error;
+
+        Job(int count, int grain, const std::function<void(int, int)>* fn)
+            : count(count), grain(grain), chunks((count + grain - 1) / grain), fn(fn), remainingChunks(chunks)
+        {
+        }
+
+        /**
+         * Claims and runs the next unclaimed chunk.
+         * @return False if every chunk has already been claimed.
+         */
+        bool runChunk()
+        {
+            const int chunk = nextChunk.fetch_add(1);
+            if (chunk >= chunks)
+            {
+                return false;
+            }
+
+            const int begin = chunk * grain;
+            const int end = std::min(count, begin + grain);
+            try
+            {
+                (*fn)(begin, end);
+            }
+            catch (...)
+            {
+                std::lock_guard lock(mutex);
+                if (!error)
+                {
+                    error = std::current_exception();
+                }
+            }
+
+            if (remainingChunks.fetch_sub(1) == 1)
+            {
+                std::lock_guard lock(mutex);
+                finished.notify_all();
+            }
+            return true;
+        }
+    };
+
+    ThreadPool::ThreadPool(int workerCount)
+    {
+        for (int i = 0; i < workerCount; ++i)
+        {
+            _workers.emplace_back([this]() { workerLoop(); });
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard lock(_mutex);
+            _stopping = true;
+        }
+        _wake.notify_all();
+        for (auto& worker : _workers)
+        {
+            worker.join();
+        }
+    }
+
+    ThreadPool& ThreadPool::shared()
+    {
+        static ThreadPool pool(std::max(0, static_cast<int>(std::thread::hardware_concurrency()) - 1));
+        return pool;
+    }
+
+    void ThreadPool::parallelFor(int count, int grain, const std::function<void(int begin, int end)>& fn)
+    {
+        if (count <= 0)
+        {
+            return;
+        }
+        grain = std::max(1, grain);
+        if (_workers.empty() || count <= grain)
+        {
+            fn(0, count);
+            return;
+        }
+
+        auto job = std::make_shared<Job>(count, grain, &fn);
+        {
+            std::lock_guard lock(_mutex);
+            _jobs.push_back(job);
+        }
+        _wake.notify_all();
+
+        while (job->runChunk())
+        {
+        }
+
+        {
+            std::lock_guard lock(_mutex);
+            auto it = std::find(_jobs.begin(), _jobs.end(), job);
+            if (it != _jobs.end())
+            {
+                _jobs.erase(it);
+            }
+        }
+        {
+            std::unique_lock lock(job->mutex);
+            job->finished.wait(lock, [&job]() { return job->remainingChunks.load() == 0; });
+        }
+
+        if (job->error)
+        {
+            std::rethrow_exception(job->error);
+        }
+    }
+
+    void ThreadPool::workerLoop()
+    {
+        while (true)
+        {
+            std::shared_ptr<Job> job;
+            {
+                std::unique_lock lock(_mutex);
+                _wake.wait(lock, [this]() { return _stopping || !_jobs.empty(); });
+                if (_stopping)
+                {
+                    return;
+                }
+                job = _jobs.front();
+            }
+
+            if (!job->runChunk())
+            {
+                // Every chunk is claimed; retire the job so idle workers go back to sleep
+                std::lock_guard lock(_mutex);
+                if (!_jobs.empty() && _jobs.front() == job)
+                {
+                    _jobs.pop_front();
+                }
+            }
+        }
+    }
+}
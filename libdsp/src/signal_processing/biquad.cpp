@@ -0,0 +1,47 @@
+#include "libdsp/signal_processing/biquad.h"
+
+#include "libdsp/signal_processing/direct_convolution.h"
+#include "simd/biquad_kernels.h"
+
+namespace dsp::signals
+{
+    namespace
+    {
+        template<typename T>
+        using BiquadKernel = void (*)(const T*, int, T*, const T*, T*, int, int);
+
+        /**
+         * The biquad kernel for the level the convolution kernels dispatch to, so setSimdLevel()
+         * steers both.
+         */
+        template<typename T>
+        BiquadKernel<T> biquadKernelFor(platform::SimdLevel level)
+        {
+            switch (level)
+            {
+#if defined(DSP_HAVE_X86_KERNELS)
+                case platform::SimdLevel::SSE2: return &simd::biquadCascadeSse2;
+                case platform::SimdLevel::AVX2: return &simd::biquadCascadeAvx2;
+                case platform::SimdLevel::AVX512: return &simd::biquadCascadeAvx512;
+#endif
+#if defined(DSP_HAVE_NEON_KERNELS)
+                case platform::SimdLevel::NEON: return &simd::biquadCascadeNeon;
+#endif
+                default: return &simd::biquadCascade<simd::BiquadScalar<T>>;
+            }
+        }
+    }
+
+    namespace detail
+    {
+        void processBiquads(const float* coefficients, int sections, float* state, const float* in, float* out, int frames, int channels)
+        {
+            biquadKernelFor<float>(activeSimdLevel())(coefficients, sections, state, in, out, frames, channels);
+        }
+
+        void processBiquads(const double* coefficients, int sections, double* state, const double* in, double* out, int frames, int channels)
+        {
+            biquadKernelFor<double>(activeSimdLevel())(coefficients, sections, state, in, out, frames, channels);
+        }
+    }
+}
@@ -0,0 +1,444 @@
+#include "libdsp/signal_processing/convolution_planner.h"
+
+#include "libdsp/signal_processing/direct_convolution.h"
+#include "libdsp/signal_processing/fast_convolution.h"
+#include "libdsp/signal_processing/partitioned_convolution.h"
+#include "libdsp/signal_processing/signal_processing.h"
+#include "libdsp/signal_processing/sparse_impulse_response.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace dsp::signals
+{
+    namespace
+    {
+        constexpr const char* CALIBRATION_HEADER = "dsp-convolution-calibration";
+        constexpr int CALIBRATION_VERSION = 1;
+        constexpr const char* CALIBRATION_ENVIRONMENT_VARIABLE = "DSP_CONVOLUTION_CALIBRATION";
+
+        constexpr ConvolutionStrategy STRATEGIES[] = {ConvolutionStrategy::Direct, ConvolutionStrategy::SimdDirect,
+                                                      ConvolutionStrategy::Fft, ConvolutionStrategy::Partitioned};
+
+        template<std::floating_point T>
+        constexpr int precisionIndex()
+        {
+            return std::is_same_v<T, float> ? 0 : 1;
+        }
+
+        int nearestLog2(int value)
+        {
+            return static_cast<int>(std::lround(std::log2(std::max(1, value))));
+        }
+
+        /**
+         * Partition size for whole-signal PartitionedConvolver runs: about four partitions per
+         * kernel, within the block sizes the FFT plans handle well.
+         */
+        int partitionBlockSize(int m)
+        {
+            return std::clamp(fft::nextPowerOfTwo(m) / 4, 64, 8192);
+        }
+
+        template<std::floating_point T>
+        void convolvePartitioned(std::span<const T> x, std::span<const T> h, std::span<T> y)
+        {
+            PartitionedConvolver<T> convolver(h, partitionBlockSize(static_cast<int>(h.size())));
+            const int latency = convolver.latency();
+            const int outputLength = static_cast<int>(y.size());
+            const int inputLength = static_cast<int>(x.size());
+
+            // Stream x followed by enough zeros to flush the tail, dropping the first `latency` outputs
+            constexpr int CHUNK = 4096;
+            std::vector<T> in(CHUNK);
+            std::vector<T> out(CHUNK);
+            const int total = outputLength + latency;
+            for (int start = 0; start < total; start += CHUNK)
+            {
+                const int count = std::min(CHUNK, total - start);
+                for (int i = 0; i < count; ++i)
+                {
+                    in[i] = start + i < inputLength ? x[start + i] : T(0);
+                }
+                convolver.process(in.data(), out.data(), count);
+                for (int i = 0; i < count; ++i)
+                {
+                    const int n = start + i - latency;
+                    if (n >= 0)
+                    {
+                        y[n] = out[i];
+                    }
+                }
+            }
+        }
+
+        template<std::floating_point T>
+        void convolveWith(ConvolutionStrategy strategy, std::span<const T> x, std::span<const T> h, std::span<T> y)
+        {
+            const size_t outputLength = x.empty() || h.empty() ? 0 : x.size() + h.size() - 1;
+            if (y.size() != outputLength)
+            {
+                throw std::invalid_argument("dsp::signals::convolve: output must hold N + M - 1 samples");
+            }
+            if (outputLength == 0)
+            {
+                return;
+            }
+            if (strategy == ConvolutionStrategy::Sparse)
+            {
+                // h stays the kernel: it's the one expected to be sparse
+                const SparseImpulseResponse<T> sparse(h);
+                convolveSparse(x.data(), static_cast<int>(x.size()), sparse.offsets().data(), sparse.gains().data(),
+                               sparse.tapCount(), y.data(), 0, static_cast<int>(y.size()));
+                return;
+            }
+            // Convolution commutes; the block strategies want the shorter sequence as the kernel
+            if (h.size() > x.size())
+            {
+                std::swap(x, h);
+            }
+
+            const int n = static_cast<int>(x.size());
+            const int m = static_cast<int>(h.size());
+            switch (strategy)
+            {
+                case ConvolutionStrategy::Direct:
+                    for (int i = 0; i < n + m - 1; ++i)
+                    {
+                        y[i] = convolveOutputSample(x.data(), n, h.data(), m, i);
+                    }
+                    break;
+                case ConvolutionStrategy::SimdDirect:
+                    convolveDirect(x.data(), n, h.data(), m, y.data());
+                    break;
+                case ConvolutionStrategy::Fft:
+                {
+                    // Same block size choice as fftConvolve1D
+                    const int fftSize = std::min(fft::nextPowerOfTwo(std::max(16, 4 * m)), fft::nextPowerOfTwo(n + m));
+                    FftConvolver<T>(h, BlockMode::OverlapSave, fftSize).convolve(x, y);
+                    break;
+                }
+                case ConvolutionStrategy::Partitioned:
+                    convolvePartitioned(x, h, y);
+                    break;
+                case ConvolutionStrategy::Sparse:
+                    break;
+            }
+        }
+
+        /**
+         * Time of one call: the best mean over a few rounds of at least a millisecond each, which
+         * filters out rounds that were interrupted by other work on the machine.
+         */
+        template<typename Fn>
+        double secondsPerCall(const Fn& fn)
+        {
+            using clock = std::chrono::steady_clock;
+            constexpr auto minimumDuration = std::chrono::milliseconds(1);
+            constexpr int ROUNDS = 3;
+
+            fn(); // warm-up: plan creation, page faults
+            double best = std::numeric_limits<double>::infinity();
+            for (int round = 0; round < ROUNDS; ++round)
+            {
+                int calls = 0;
+                const auto start = clock::now();
+                auto elapsed = clock::duration::zero();
+                do
+                {
+                    fn();
+                    ++calls;
+                    elapsed = clock::now() - start;
+                } while (elapsed < minimumDuration);
+                best = std::min(best, std::chrono::duration<double>(elapsed).count() / calls);
+            }
+            return best;
+        }
+    }
+
+    const char* strategyName(ConvolutionStrategy strategy)
+    {
+        switch (strategy)
+        {
+            case ConvolutionStrategy::Direct: return "direct";
+            case ConvolutionStrategy::SimdDirect: return "simd";
+            case ConvolutionStrategy::Fft: return "fft";
+            case ConvolutionStrategy::Partitioned: return "partitioned";
+            case ConvolutionStrategy::Sparse: return "sparse";
+        }
+        return "unknown";
+    }
+
+    ConvolutionPlanner& ConvolutionPlanner::instance()
+    {
+        static ConvolutionPlanner planner;
+        static const bool loaded = [] {
+            const char* path = std::getenv(CALIBRATION_ENVIRONMENT_VARIABLE);
+            return path != nullptr && planner.loadCalibration(path);
+        }();
+        (void)loaded;
+        return planner;
+    }
+
+    ConvolutionPlanner::ConvolutionPlanner()
+        : _table(defaultTable())
+    {
+    }
+
+    ConvolutionPlanner::Table ConvolutionPlanner::defaultTable()
+    {
+        // Conservative guess for a machine with at least SSE2/NEON: the vectorized direct form
+        // wins up to a few hundred taps, the FFT beyond
+        Table table{};
+        for (auto& precision : table)
+        {
+            for (auto& row : precision)
+            {
+                for (int log2M = 0; log2M < M_CELLS; ++log2M)
+                {
+                    row[log2M] = log2M <= 8 ? ConvolutionStrategy::SimdDirect : ConvolutionStrategy::Fft;
+                }
+            }
+        }
+        return table;
+    }
+
+    ConvolutionStrategy ConvolutionPlanner::choose(int n, int m, fft::Precision precision) const
+    {
+        const int longer = std::max(n, m);
+        const int shorter = std::min(n, m);
+        const int nCell = std::clamp((nearestLog2(longer) - MIN_LOG2_N + 1) / 2, 0, N_CELLS - 1);
+        const int mCell = std::clamp(nearestLog2(shorter), 0, M_CELLS - 1);
+
+        std::shared_lock lock(_mutex);
+        return _table[precision == fft::Precision::Single ? 0 : 1][nCell][mCell];
+    }
+
+    template<std::floating_point T>
+    void ConvolutionPlanner::calibratePrecision(Table& table) const
+    {
+        std::mt19937 gen{1234};
+        std::uniform_real_distribution<T> distribution{T(-1), T(1)};
+
+        for (int nCell = 0; nCell < N_CELLS; ++nCell)
+        {
+            const int n = 1 << (MIN_LOG2_N + 2 * nCell);
+            std::vector<T> x(n);
+            for (T& sample : x)
+            {
+                sample = distribution(gen);
+            }
+
+            std::array<bool, std::size(STRATEGIES)> retired{};
+            for (int mCell = 0; mCell < M_CELLS; ++mCell)
+            {
+                const int m = 1 << mCell;
+                if (m > n)
+                {
+                    // Same problem with the roles swapped; reuse the m == n decision
+                    table[precisionIndex<T>()][nCell][mCell] = table[precisionIndex<T>()][nCell][mCell - 1];
+                    continue;
+                }
+
+                std::vector<T> h(m);
+                for (T& tap : h)
+                {
+                    tap = distribution(gen);
+                }
+                std::vector<T> y(n + m - 1);
+
+                std::array<double, std::size(STRATEGIES)> times{};
+                double best = std::numeric_limits<double>::infinity();
+                for (size_t s = 0; s < std::size(STRATEGIES); ++s)
+                {
+                    times[s] = std::numeric_limits<double>::infinity();
+                    if (retired[s])
+                    {
+                        continue;
+                    }
+                    times[s] = secondsPerCall([&]() {
+                        convolveWith<T>(STRATEGIES[s], x, h, y);
+                    });
+                    best = std::min(best, times[s]);
+                }
+
+                size_t winner = 0;
+                for (size_t s = 0; s < std::size(STRATEGIES); ++s)
+                {
+                    if (times[s] < times[winner])
+                    {
+                        winner = s;
+                    }
+                    // Direct-form cost grows linearly with m and the block methods' only
+                    // logarithmically, so a direct method this far behind never catches up
+                    const bool direct = STRATEGIES[s] == ConvolutionStrategy::Direct ||
+                                        STRATEGIES[s] == ConvolutionStrategy::SimdDirect;
+                    retired[s] = retired[s] || (direct && times[s] > 8 * best);
+                }
+                table[precisionIndex<T>()][nCell][mCell] = STRATEGIES[winner];
+            }
+        }
+    }
+
+    void ConvolutionPlanner::calibrate()
+    {
+        // Measure into a copy so choose() keeps working (on the old table) meanwhile
+        Table table = defaultTable();
+        calibratePrecision<float>(table);
+        calibratePrecision<double>(table);
+
+        std::unique_lock lock(_mutex);
+        _table = table;
+        _calibrated = true;
+    }
+
+    bool ConvolutionPlanner::isCalibrated() const
+    {
+        std::shared_lock lock(_mutex);
+        return _calibrated;
+    }
+
+    /**
+     * The calibration file is a header line followed by one line per (precision, signal length) cell,
+     *   <f32|f64> <log2 N> <strategy for M = 2^0> <strategy for M = 2^1> ... <strategy for M = 2^MAX_LOG2_M>
+     */
+    bool ConvolutionPlanner::saveCalibration(const std::string& path) const
+    {
+        std::ofstream file(path);
+        if (!file)
+        {
+            return false;
+        }
+
+        file << CALIBRATION_HEADER << " " << CALIBRATION_VERSION << "\n";
+
+        std::shared_lock lock(_mutex);
+        for (int precision = 0; precision < 2; ++precision)
+        {
+            for (int nCell = 0; nCell < N_CELLS; ++nCell)
+            {
+                file << (precision == 0 ? "f32" : "f64") << " " << MIN_LOG2_N + 2 * nCell;
+                for (ConvolutionStrategy strategy : _table[precision][nCell])
+                {
+                    file << " " << strategyName(strategy);
+                }
+                file << "\n";
+            }
+        }
+        return static_cast<bool>(file);
+    }
+
+    bool ConvolutionPlanner::loadCalibration(const std::string& path)
+    {
+        std::ifstream file(path);
+        if (!file)
+        {
+            return false;
+        }
+
+        std::string header;
+        int version = 0;
+        if (!(file >> header >> version) || header != CALIBRATION_HEADER || version != CALIBRATION_VERSION)
+        {
+            return false;
+        }
+
+        // Every cell must be present; a partial table would silently mix in the defaults
+        Table table{};
+        std::array<std::array<bool, N_CELLS>, 2> seen{};
+        std::string line;
+        std::getline(file, line); // Rest of the header line
+        while (std::getline(file, line))
+        {
+            if (line.empty())
+            {
+                continue;
+            }
+
+            std::istringstream fields(line);
+            std::string precision;
+            int log2N = 0;
+            if (!(fields >> precision >> log2N) || (precision != "f32" && precision != "f64") ||
+                log2N < MIN_LOG2_N || log2N > MAX_LOG2_N || (log2N - MIN_LOG2_N) % 2 != 0)
+            {
+                return false;
+            }
+
+            const int p = precision == "f32" ? 0 : 1;
+            const int nCell = (log2N - MIN_LOG2_N) / 2;
+            for (int mCell = 0; mCell < M_CELLS; ++mCell)
+            {
+                std::string name;
+                if (!(fields >> name))
+                {
+                    return false;
+                }
+                const auto* match = std::find_if(std::begin(STRATEGIES), std::end(STRATEGIES), [&](ConvolutionStrategy s) {
+                    return name == strategyName(s);
+                });
+                if (match == std::end(STRATEGIES))
+                {
+                    return false;
+                }
+                table[p][nCell][mCell] = *match;
+            }
+            seen[p][nCell] = true;
+        }
+
+        for (const auto& precision : seen)
+        {
+            if (std::find(precision.begin(), precision.end(), false) != precision.end())
+            {
+                return false;
+            }
+        }
+
+        std::unique_lock lock(_mutex);
+        _table = table;
+        _calibrated = true;
+        return true;
+    }
+
+    void ConvolutionPlanner::reset()
+    {
+        std::unique_lock lock(_mutex);
+        _table = defaultTable();
+        _calibrated = false;
+    }
+
+    void convolve(std::span<const float> x, std::span<const float> h, std::span<float> y)
+    {
+        const auto strategy = detail::preferSparse(h)
+                ? ConvolutionStrategy::Sparse
+                : ConvolutionPlanner::instance().choose(static_cast<int>(x.size()), static_cast<int>(h.size()), fft::Precision::Single);
+        convolveWith(strategy, x, h, y);
+    }
+
+    void convolve(std::span<const double> x, std::span<const double> h, std::span<double> y)
+    {
+        const auto strategy = detail::preferSparse(h)
+                ? ConvolutionStrategy::Sparse
+                : ConvolutionPlanner::instance().choose(static_cast<int>(x.size()), static_cast<int>(h.size()), fft::Precision::Double);
+        convolveWith(strategy, x, h, y);
+    }
+
+    void convolve(ConvolutionStrategy strategy, std::span<const float> x, std::span<const float> h, std::span<float> y)
+    {
+        convolveWith(strategy, x, h, y);
+    }
+
+    void convolve(ConvolutionStrategy strategy, std::span<const double> x, std::span<const double> h, std::span<double> y)
+    {
+        convolveWith(strategy, x, h, y);
+    }
+}
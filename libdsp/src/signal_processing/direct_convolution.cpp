@@ -0,0 +1,302 @@
+#include "libdsp/signal_processing/direct_convolution.h"
+
+#include "simd/direct_kernels.h"
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+namespace dsp::signals
+{
+    namespace
+    {
+        template<typename T>
+        struct ScalarTraits
+        {
+            using Scalar = T;
+            using Vector = T;
+            static constexpr int WIDTH = 1;
+            static Vector zero() { return T(0); }
+            static Vector broadcast(T s) { return s; }
+            static Vector load(const T* p) { return *p; }
+            static void store(T* p, Vector v) { *p = v; }
+            static Vector multiplyAdd(Vector a, Vector b, Vector c) { return a * b + c; }
+            static Vector add(Vector a, Vector b) { return a + b; }
+            static Vector subtract(Vector a, Vector b) { return a - b; }
+            static T sum(Vector v) { return v; }
+        };
+
+        template<typename T>
+        using Kernel = void (*)(const T*, const T*, int, T*, int);
+
+        template<typename T>
+        using DotKernel = T (*)(const T*, const T*, int);
+
+        template<typename T>
+        using FoldedKernel = void (*)(const T*, const T*, int, bool, T*, int);
+
+        template<typename T>
+        using SparseKernel = void (*)(const T*, int, const int*, const T*, int, T*, int, int);
+
+        /**
+         * @return True if this build contains kernels for `level`, on top of the host supporting it.
+         */
+        bool isAvailable(platform::SimdLevel level)
+        {
+            switch (level)
+            {
+                case platform::SimdLevel::Scalar:
+                    return true;
+#if defined(DSP_HAVE_X86_KERNELS)
+                case platform::SimdLevel::SSE2:
+                case platform::SimdLevel::AVX2:
+                case platform::SimdLevel::AVX512:
+                    return platform::isSupported(level);
+#endif
+#if defined(DSP_HAVE_NEON_KERNELS)
+                case platform::SimdLevel::NEON:
+                    return platform::isSupported(level);
+#endif
+                default:
+                    return false;
+            }
+        }
+
+        std::atomic<platform::SimdLevel>& currentLevel()
+        {
+            static std::atomic<platform::SimdLevel> level = [] {
+                const platform::SimdLevel best = platform::bestSimdLevel();
+                return isAvailable(best) ? best : platform::SimdLevel::Scalar;
+            }();
+            return level;
+        }
+
+        template<typename T>
+        Kernel<T> kernelFor(platform::SimdLevel level)
+        {
+            switch (level)
+            {
+#if defined(DSP_HAVE_X86_KERNELS)
+                case platform::SimdLevel::SSE2: return &simd::steadyStateSse2;
+                case platform::SimdLevel::AVX2: return &simd::steadyStateAvx2;
+                case platform::SimdLevel::AVX512: return &simd::steadyStateAvx512;
+#endif
+#if defined(DSP_HAVE_NEON_KERNELS)
+                case platform::SimdLevel::NEON: return &simd::steadyStateNeon;
+#endif
+                default: return &simd::steadyState<ScalarTraits<T>>;
+            }
+        }
+
+        template<typename T>
+        DotKernel<T> dotKernelFor(platform::SimdLevel level)
+        {
+            switch (level)
+            {
+#if defined(DSP_HAVE_X86_KERNELS)
+                case platform::SimdLevel::SSE2: return &simd::dotSse2;
+                case platform::SimdLevel::AVX2: return &simd::dotAvx2;
+                case platform::SimdLevel::AVX512: return &simd::dotAvx512;
+#endif
+#if defined(DSP_HAVE_NEON_KERNELS)
+                case platform::SimdLevel::NEON: return &simd::dotNeon;
+#endif
+                default: return &simd::dot<ScalarTraits<T>>;
+            }
+        }
+
+        template<typename T>
+        FoldedKernel<T> foldedKernelFor(platform::SimdLevel level)
+        {
+            switch (level)
+            {
+#if defined(DSP_HAVE_X86_KERNELS)
+                case platform::SimdLevel::SSE2: return &simd::steadyStateFoldedSse2;
+                case platform::SimdLevel::AVX2: return &simd::steadyStateFoldedAvx2;
+                case platform::SimdLevel::AVX512: return &simd::steadyStateFoldedAvx512;
+#endif
+#if defined(DSP_HAVE_NEON_KERNELS)
+                case platform::SimdLevel::NEON: return &simd::steadyStateFoldedNeon;
+#endif
+                default: return &simd::steadyStateFolded<ScalarTraits<T>>;
+            }
+        }
+
+        template<typename T>
+        SparseKernel<T> sparseKernelFor(platform::SimdLevel level)
+        {
+            switch (level)
+            {
+#if defined(DSP_HAVE_X86_KERNELS)
+                case platform::SimdLevel::SSE2: return &simd::sparseAccumulateSse2;
+                case platform::SimdLevel::AVX2: return &simd::sparseAccumulateAvx2;
+                case platform::SimdLevel::AVX512: return &simd::sparseAccumulateAvx512;
+#endif
+#if defined(DSP_HAVE_NEON_KERNELS)
+                case platform::SimdLevel::NEON: return &simd::sparseAccumulateNeon;
+#endif
+                default: return &simd::sparseAccumulate<ScalarTraits<T>>;
+            }
+        }
+
+        template<typename T>
+        void validImpl(const T* x, int n, const T* h, int m, T* y)
+        {
+            if (n >= m && m > 0)
+            {
+                kernelFor<T>(currentLevel().load(std::memory_order_relaxed))(x, h, m, y, n - m + 1);
+            }
+        }
+
+        /**
+         * Full convolution around a steady-state kernel steady(window, y, count), for n >= m.
+         */
+        template<typename T, typename Steady>
+        void runDirect(const T* x, int n, int m, T* y, const Steady& steady)
+        {
+            steady(x, y + m - 1, n - m + 1);
+
+            const int edge = m - 1;
+            if (edge == 0)
+            {
+                return;
+            }
+
+            // Head: m - 1 zeros in front of x[0, m - 1). Tail: x[n - m + 1, n) followed by m - 1 zeros.
+            std::vector<T> padded(2 * edge, T(0));
+            std::copy_n(x, edge, padded.begin() + edge);
+            steady(padded.data(), y, edge);
+
+            std::fill(padded.begin() + edge, padded.end(), T(0));
+            std::copy_n(x + n - edge, edge, padded.begin());
+            steady(padded.data(), y + n, edge);
+        }
+
+        template<typename T>
+        void directImpl(const T* x, int n, const T* h, int m, T* y)
+        {
+            if (n <= 0 || m <= 0)
+            {
+                return;
+            }
+            // Convolution commutes; slide the shorter sequence across the longer one
+            if (m > n)
+            {
+                std::swap(x, h);
+                std::swap(n, m);
+            }
+
+            const Kernel<T> kernel = kernelFor<T>(currentLevel().load(std::memory_order_relaxed));
+            runDirect(x, n, m, y, [&](const T* window, T* out, int count) { kernel(window, h, m, out, count); });
+        }
+
+        template<typename T>
+        void validFoldedImpl(const T* x, int n, const T* h, int m, FirSymmetry symmetry, T* y)
+        {
+            if (symmetry == FirSymmetry::None)
+            {
+                validImpl(x, n, h, m, y);
+            }
+            else if (n >= m && m > 0)
+            {
+                foldedKernelFor<T>(currentLevel().load(std::memory_order_relaxed))(
+                        x, h, m, symmetry == FirSymmetry::Antisymmetric, y, n - m + 1);
+            }
+        }
+
+        template<typename T>
+        void directFoldedImpl(const T* x, int n, const T* h, int m, FirSymmetry symmetry, T* y)
+        {
+            // Swapping x and h would lose the symmetry, so a kernel longer than the signal goes the plain way
+            if (symmetry == FirSymmetry::None || m > n)
+            {
+                directImpl(x, n, h, m, y);
+                return;
+            }
+            if (n <= 0 || m <= 0)
+            {
+                return;
+            }
+
+            const FoldedKernel<T> kernel = foldedKernelFor<T>(currentLevel().load(std::memory_order_relaxed));
+            const bool antisymmetric = symmetry == FirSymmetry::Antisymmetric;
+            runDirect(x, n, m, y, [&](const T* window, T* out, int count) { kernel(window, h, m, antisymmetric, out, count); });
+        }
+    }
+
+    void convolveDirect(const float* x, int n, const float* h, int m, float* y)
+    {
+        directImpl(x, n, h, m, y);
+    }
+
+    void convolveDirect(const double* x, int n, const double* h, int m, double* y)
+    {
+        directImpl(x, n, h, m, y);
+    }
+
+    void convolveValid(const float* x, int n, const float* h, int m, float* y)
+    {
+        validImpl(x, n, h, m, y);
+    }
+
+    void convolveValid(const double* x, int n, const double* h, int m, double* y)
+    {
+        validImpl(x, n, h, m, y);
+    }
+
+    void convolveValidFolded(const float* x, int n, const float* h, int m, FirSymmetry symmetry, float* y)
+    {
+        validFoldedImpl(x, n, h, m, symmetry, y);
+    }
+
+    void convolveValidFolded(const double* x, int n, const double* h, int m, FirSymmetry symmetry, double* y)
+    {
+        validFoldedImpl(x, n, h, m, symmetry, y);
+    }
+
+    void convolveDirectFolded(const float* x, int n, const float* h, int m, FirSymmetry symmetry, float* y)
+    {
+        directFoldedImpl(x, n, h, m, symmetry, y);
+    }
+
+    void convolveDirectFolded(const double* x, int n, const double* h, int m, FirSymmetry symmetry, double* y)
+    {
+        directFoldedImpl(x, n, h, m, symmetry, y);
+    }
+
+    void convolveSparse(const float* x, int n, const int* offsets, const float* gains, int taps, float* y, int first, int count)
+    {
+        sparseKernelFor<float>(currentLevel().load(std::memory_order_relaxed))(x, n, offsets, gains, taps, y, first, count);
+    }
+
+    void convolveSparse(const double* x, int n, const int* offsets, const double* gains, int taps, double* y, int first, int count)
+    {
+        sparseKernelFor<double>(currentLevel().load(std::memory_order_relaxed))(x, n, offsets, gains, taps, y, first, count);
+    }
+
+    float dotProduct(const float* a, const float* b, int count)
+    {
+        return dotKernelFor<float>(currentLevel().load(std::memory_order_relaxed))(a, b, count);
+    }
+
+    double dotProduct(const double* a, const double* b, int count)
+    {
+        return dotKernelFor<double>(currentLevel().load(std::memory_order_relaxed))(a, b, count);
+    }
+
+    platform::SimdLevel activeSimdLevel()
+    {
+        return currentLevel().load(std::memory_order_relaxed);
+    }
+
+    bool setSimdLevel(platform::SimdLevel level)
+    {
+        if (!isAvailable(level))
+        {
+            return false;
+        }
+        currentLevel().store(level, std::memory_order_relaxed);
+        return true;
+    }
+}
@@ -0,0 +1,250 @@
+#include "libdsp/signal_processing/fixed_point_convolution.h"
+
+#include "libdsp/platform/cpu_features.h"
+#include "libdsp/signal_processing/direct_convolution.h"
+#include "simd/fixed_point_kernels.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace dsp::signals
+{
+    namespace
+    {
+        struct ScalarQ15
+        {
+            using Vector = int;
+            using Coefficient = int;
+            using Accumulator = int;
+            static constexpr int WIDTH = 1;
+            static Accumulator zero() { return 0; }
+            static Coefficient broadcast(int pair) { return pair; }
+            static Vector load(const int* p) { return *p; }
+            static Accumulator multiplyAdd(Vector x, Coefficient c, Accumulator a) { return a + simd::multiplyPair(x, c); }
+            static void store(short* y, Accumulator a) { y[0] = simd::roundQ15(a); }
+        };
+
+        // Outputs per interleaved chunk of input, small enough for the chunk to stay in L1 / L2
+        constexpr int Q15_CHUNK = 2048;
+
+        using Q15Kernel = void (*)(const int*, const int*, int, short*, int);
+
+        /**
+         * The Q15 kernel for the level the floating point kernels dispatch to, so setSimdLevel()
+         * steers both. AVX-512 without BW has no 16-bit integer instructions and drops to AVX2.
+         */
+        Q15Kernel q15KernelFor(platform::SimdLevel level)
+        {
+            switch (level)
+            {
+#if defined(DSP_HAVE_X86_KERNELS)
+                case platform::SimdLevel::SSE2: return &simd::steadyStateQ15Sse2;
+                case platform::SimdLevel::AVX2: return &simd::steadyStateQ15Avx2;
+                case platform::SimdLevel::AVX512:
+                    return platform::cpuFeatures().avx512bw ? &simd::steadyStateQ15Avx512 : &simd::steadyStateQ15Avx2;
+#endif
+#if defined(DSP_HAVE_NEON_KERNELS)
+                case platform::SimdLevel::NEON: return &simd::steadyStateQ15Neon;
+#endif
+                default: return &simd::steadyStateQ15<ScalarQ15>;
+            }
+        }
+
+        /**
+         * Steady-state outputs y[k], 0 <= k < count, of a fixed-point filter with taps fixed at construction.
+         */
+        class Q15Steady
+        {
+        public:
+            /**
+             * @return low in the low and high in the high half of a 32-bit word.
+             */
+            static int pack(short low, short high)
+            {
+                return static_cast<int>(static_cast<unsigned short>(low) | (static_cast<unsigned>(static_cast<unsigned short>(high)) << 16));
+            }
+
+            Q15Steady(const short* h, int m) : _h(h), _m(m)
+            {
+                // |x| <= 2^15, so 32-bit sums (and each pmaddwd pair) stay below 2^31 while \sum |h| < 2^16
+                long long magnitude = 0;
+                for (int j = 0; j < m; ++j)
+                {
+                    magnitude += std::abs(static_cast<int>(h[j]));
+                }
+                if (magnitude <= 65535)
+                {
+                    _pairs.resize((m + 1) / 2);
+                    for (int p = 0; p < static_cast<int>(_pairs.size()); ++p)
+                    {
+                        _pairs[p] = pack(h[2 * p], 2 * p + 1 < m ? h[2 * p + 1] : short(0));
+                    }
+                    _kernel = q15KernelFor(activeSimdLevel());
+                }
+            }
+
+            void operator()(const short* x, short* y, int count) const
+            {
+                if (_kernel)
+                {
+                    // The kernels read x as (x[i], x[i - 1]) pairs; interleave a chunk at a time.
+                    // x[-1] only ever meets the zero tap past an odd last tap, so 0 stands in for it
+                    std::vector<int> x2(std::min(count, Q15_CHUNK) + _m - 1);
+                    for (int start = 0; start < count; start += Q15_CHUNK)
+                    {
+                        const int outputs = std::min(Q15_CHUNK, count - start);
+                        const short* window = x + start;
+                        x2[0] = pack(window[0], start > 0 ? window[-1] : short(0));
+                        for (int i = 1; i < outputs + _m - 1; ++i)
+                        {
+                            x2[i] = pack(window[i], window[i - 1]);
+                        }
+                        _kernel(x2.data(), _pairs.data(), _m, y + start, outputs);
+                    }
+                    return;
+                }
+                for (int k = 0; k < count; ++k)
+                {
+                    const short* newest = x + k + _m - 1;
+                    long long accumulator = 0;
+                    for (int j = 0; j < _m; ++j)
+                    {
+                        accumulator += _h[j] * newest[-j];
+                    }
+                    const long long result = (accumulator + (1 << 14)) >> 15;
+                    y[k] = static_cast<short>(std::clamp<long long>(result, -32768, 32767));
+                }
+            }
+
+        private:
+            const short* _h;
+            int _m;
+            std::vector<int> _pairs;
+            Q15Kernel _kernel = nullptr;
+        };
+
+        class Q31Steady
+        {
+        public:
+            Q31Steady(const std::int32_t* h, int m) : _h(h), _m(m)
+            {
+                // |x| <= 2^31, so 64-bit sums stay below 2^63 while \sum |h| < 2^32
+                unsigned long long magnitude = 0;
+                for (int j = 0; j < m; ++j)
+                {
+                    magnitude += static_cast<unsigned long long>(std::llabs(h[j]));
+                }
+                _fits = magnitude < (1ULL << 32);
+            }
+
+            void operator()(const std::int32_t* x, std::int32_t* y, int count) const
+            {
+                constexpr long long lowest = std::numeric_limits<std::int32_t>::min();
+                constexpr long long highest = std::numeric_limits<std::int32_t>::max();
+                for (int k = 0; k < count; ++k)
+                {
+                    const std::int32_t* newest = x + k + _m - 1;
+                    long long result = 0;
+                    if (_fits)
+                    {
+                        long long accumulator = 0;
+                        for (int j = 0; j < _m; ++j)
+                        {
+                            accumulator += static_cast<long long>(_h[j]) * newest[-j];
+                        }
+                        result = (accumulator + (1LL << 30)) >> 31;
+                    }
+                    else
+                    {
+                        // Sum = high * 2^32 + low, with each product split into its (floored) upper
+                        // and its unsigned lower 32 bits. Then round(sum / 2^31) = 2 * high + round(low / 2^31)
+                        long long high = 0;
+                        unsigned long long low = 0;
+                        for (int j = 0; j < _m; ++j)
+                        {
+                            const long long product = static_cast<long long>(_h[j]) * newest[-j];
+                            high += product >> 32;
+                            low += static_cast<unsigned long long>(product) & 0xffffffffULL;
+                        }
+                        result = 2 * high + static_cast<long long>((low + (1ULL << 30)) >> 31);
+                    }
+                    y[k] = static_cast<std::int32_t>(std::clamp(result, lowest, highest));
+                }
+            }
+
+        private:
+            const std::int32_t* _h;
+            int _m;
+            bool _fits = true;
+        };
+
+        template<typename Steady, typename T>
+        void validImpl(const T* x, int n, const T* h, int m, T* y)
+        {
+            if (n >= m && m > 0)
+            {
+                Steady(h, m)(x, y, n - m + 1);
+            }
+        }
+
+        /**
+         * Full convolution from a steady-state kernel, laid out like the floating point convolveDirect.
+         */
+        template<typename Steady, typename T>
+        void directImpl(const T* x, int n, const T* h, int m, T* y)
+        {
+            if (n <= 0 || m <= 0)
+            {
+                return;
+            }
+            // Integer sums are exact, so sliding the shorter sequence gives identical results
+            if (m > n)
+            {
+                std::swap(x, h);
+                std::swap(n, m);
+            }
+
+            const Steady steady(h, m);
+            steady(x, y + m - 1, n - m + 1);
+
+            const int edge = m - 1;
+            if (edge == 0)
+            {
+                return;
+            }
+
+            // Head: m - 1 zeros in front of x[0, m - 1). Tail: x[n - m + 1, n) followed by m - 1 zeros.
+            std::vector<T> padded(2 * edge, T(0));
+            std::copy_n(x, edge, padded.begin() + edge);
+            steady(padded.data(), y, edge);
+
+            std::fill(padded.begin() + edge, padded.end(), T(0));
+            std::copy_n(x + n - edge, edge, padded.begin());
+            steady(padded.data(), y + n, edge);
+        }
+    }
+
+    void convolveDirectQ15(const std::int16_t* x, int n, const std::int16_t* h, int m, std::int16_t* y)
+    {
+        directImpl<Q15Steady>(x, n, h, m, y);
+    }
+
+    void convolveValidQ15(const std::int16_t* x, int n, const std::int16_t* h, int m, std::int16_t* y)
+    {
+        validImpl<Q15Steady>(x, n, h, m, y);
+    }
+
+    void convolveDirectQ31(const std::int32_t* x, int n, const std::int32_t* h, int m, std::int32_t* y)
+    {
+        directImpl<Q31Steady>(x, n, h, m, y);
+    }
+
+    void convolveValidQ31(const std::int32_t* x, int n, const std::int32_t* h, int m, std::int32_t* y)
+    {
+        validImpl<Q31Steady>(x, n, h, m, y);
+    }
+}
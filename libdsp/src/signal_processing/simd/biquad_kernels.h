@@ -0,0 +1,162 @@
+#ifndef SIGNAL_PROCESSING_BOOK_BIQUAD_KERNELS_H
+#define SIGNAL_PROCESSING_BOOK_BIQUAD_KERNELS_H
+
+// Private to libdsp, and like direct_kernels.h free of standard library includes.
+
+namespace dsp::signals::simd
+{
+    // Frames run through every section of a channel group before moving on, so the group's samples
+    // stay in L1 between sections
+    constexpr int BIQUAD_FRAME_BLOCK = 128;
+
+    // Everything below is instantiated with the baseline BiquadScalar traits too, in the ISA files as
+    // well as biquad.cpp. Internal linkage keeps each file's copy to itself, so the linker can't
+    // replace the baseline fallback with one compiled for AVX.
+    namespace
+    {
+        /**
+         * One channel per "vector", for the channels left over after the last full vector.
+         */
+        template<typename T>
+        struct BiquadScalar
+        {
+            using Scalar = T;
+            using Vector = T;
+            static constexpr int WIDTH = 1;
+            static Vector zero() { return T(0); }
+            static Vector broadcast(T s) { return s; }
+            static Vector load(const T* p) { return *p; }
+            static void store(T* p, Vector v) { *p = v; }
+            static Vector multiplyAdd(Vector a, Vector b, Vector c) { return a * b + c; }
+        };
+
+        /**
+         * One transposed direct-form II step of a section, on WIDTH channels at once:
+         *   y = b0 x + s1,  s1 = b1 x - a1 y + s2,  s2 = b2 x - a2 y
+         * `k` holds b0, b1, b2, -a1, -a2 already broadcast.
+         */
+        template<typename V>
+        inline typename V::Vector biquadStep(const typename V::Vector* k, typename V::Vector x,
+                                             typename V::Vector& s1, typename V::Vector& s2)
+        {
+            const typename V::Vector y = V::multiplyAdd(k[0], x, s1);
+            s1 = V::multiplyAdd(k[3], y, V::multiplyAdd(k[1], x, s2));
+            s2 = V::multiplyAdd(k[4], y, V::multiplyAdd(k[2], x, V::zero()));
+            return y;
+        }
+
+        /**
+         * Runs frames [0, frames) of VECTORS * WIDTH adjacent channels, starting at `channel`, through
+         * every section. Each vector is an independent recursion, so several in flight hide the
+         * multiply-add latency the single recursion of one channel is bound by.
+         */
+        template<typename V, int VECTORS>
+        void biquadGroup(const typename V::Scalar* coefficients, int sections, typename V::Scalar* state,
+                         const typename V::Scalar* in, typename V::Scalar* out, int frames, int channels, int channel)
+        {
+            using T = typename V::Scalar;
+            constexpr int W = V::WIDTH;
+            static_assert(VECTORS == 1 || VECTORS == 4);
+
+            for (int start = 0; start < frames; start += BIQUAD_FRAME_BLOCK)
+            {
+                const int end = start + BIQUAD_FRAME_BLOCK < frames ? start + BIQUAD_FRAME_BLOCK : frames;
+                for (int s = 0; s < sections; ++s)
+                {
+                    const T* c = coefficients + 5 * s;
+                    const typename V::Vector k[5] = {V::broadcast(c[0]), V::broadcast(c[1]), V::broadcast(c[2]),
+                                                     V::broadcast(-c[3]), V::broadcast(-c[4])};
+                    T* s1 = state + 2 * s * channels + channel;
+                    T* s2 = s1 + channels;
+                    // Sections after the first filter the previous section's output in place
+                    const T* source = s == 0 ? in : out;
+
+                    if constexpr (VECTORS == 4)
+                    {
+                        typename V::Vector s10 = V::load(s1), s11 = V::load(s1 + W), s12 = V::load(s1 + 2 * W), s13 = V::load(s1 + 3 * W);
+                        typename V::Vector s20 = V::load(s2), s21 = V::load(s2 + W), s22 = V::load(s2 + 2 * W), s23 = V::load(s2 + 3 * W);
+                        for (int f = start; f < end; ++f)
+                        {
+                            const T* x = source + f * channels + channel;
+                            T* y = out + f * channels + channel;
+                            const typename V::Vector y0 = biquadStep<V>(k, V::load(x), s10, s20);
+                            const typename V::Vector y1 = biquadStep<V>(k, V::load(x + W), s11, s21);
+                            const typename V::Vector y2 = biquadStep<V>(k, V::load(x + 2 * W), s12, s22);
+                            const typename V::Vector y3 = biquadStep<V>(k, V::load(x + 3 * W), s13, s23);
+                            V::store(y, y0);
+                            V::store(y + W, y1);
+                            V::store(y + 2 * W, y2);
+                            V::store(y + 3 * W, y3);
+                        }
+                        V::store(s1, s10);
+                        V::store(s1 + W, s11);
+                        V::store(s1 + 2 * W, s12);
+                        V::store(s1 + 3 * W, s13);
+                        V::store(s2, s20);
+                        V::store(s2 + W, s21);
+                        V::store(s2 + 2 * W, s22);
+                        V::store(s2 + 3 * W, s23);
+                    }
+                    else
+                    {
+                        typename V::Vector s10 = V::load(s1);
+                        typename V::Vector s20 = V::load(s2);
+                        for (int f = start; f < end; ++f)
+                        {
+                            V::store(out + f * channels + channel, biquadStep<V>(k, V::load(source + f * channels + channel), s10, s20));
+                        }
+                        V::store(s1, s10);
+                        V::store(s2, s20);
+                    }
+                }
+            }
+        }
+
+        /**
+         * Cascade of second-order sections over `frames` frames of `channels` interleaved channels
+         * (sample f of channel c at f * channels + c), with one channel per SIMD lane. Channels go
+         * four vectors at a time, then one vector at a time, and what is left over without SIMD.
+         *
+         * `coefficients` holds b0, b1, b2, a1, a2 for each section (a0 normalized to 1). `state` holds
+         * s1 for every channel, then s2 for every channel, for each section in turn.
+         * `in` and `out` may be the same buffer.
+         * @tparam V Instruction set traits as for steadyState.
+         */
+        template<typename V>
+        void biquadCascade(const typename V::Scalar* coefficients, int sections, typename V::Scalar* state,
+                           const typename V::Scalar* in, typename V::Scalar* out, int frames, int channels)
+        {
+            constexpr int W = V::WIDTH;
+            int c = 0;
+            for (; c + 4 * W <= channels; c += 4 * W)
+            {
+                biquadGroup<V, 4>(coefficients, sections, state, in, out, frames, channels, c);
+            }
+            for (; c + W <= channels; c += W)
+            {
+                biquadGroup<V, 1>(coefficients, sections, state, in, out, frames, channels, c);
+            }
+            for (; c + 4 <= channels; c += 4)
+            {
+                biquadGroup<BiquadScalar<typename V::Scalar>, 4>(coefficients, sections, state, in, out, frames, channels, c);
+            }
+            for (; c < channels; ++c)
+            {
+                biquadGroup<BiquadScalar<typename V::Scalar>, 1>(coefficients, sections, state, in, out, frames, channels, c);
+            }
+        }
+    }
+
+    // One entry point per instruction set, each defined in kernels_<isa>.cpp.
+    // Only call a kernel after checking the host supports its instruction set.
+    void biquadCascadeSse2(const float* coefficients, int sections, float* state, const float* in, float* out, int frames, int channels);
+    void biquadCascadeSse2(const double* coefficients, int sections, double* state, const double* in, double* out, int frames, int channels);
+    void biquadCascadeAvx2(const float* coefficients, int sections, float* state, const float* in, float* out, int frames, int channels);
+    void biquadCascadeAvx2(const double* coefficients, int sections, double* state, const double* in, double* out, int frames, int channels);
+    void biquadCascadeAvx512(const float* coefficients, int sections, float* state, const float* in, float* out, int frames, int channels);
+    void biquadCascadeAvx512(const double* coefficients, int sections, double* state, const double* in, double* out, int frames, int channels);
+    void biquadCascadeNeon(const float* coefficients, int sections, float* state, const float* in, float* out, int frames, int channels);
+    void biquadCascadeNeon(const double* coefficients, int sections, double* state, const double* in, double* out, int frames, int channels);
+}
+
+#endif //SIGNAL_PROCESSING_BOOK_BIQUAD_KERNELS_H
@@ -0,0 +1,330 @@
+#ifndef SIGNAL_PROCESSING_BOOK_DIRECT_KERNELS_H
+#define SIGNAL_PROCESSING_BOOK_DIRECT_KERNELS_H
+
+// Private to libdsp. Each kernels_<isa>.cpp is compiled with its own instruction set flags, so
+// nothing from the standard library is included here: any inline std:: function instantiated in
+// one of those files could be merged with (and replace) the baseline copy used everywhere else.
+
+namespace dsp::signals::simd
+{
+    /**
+     * Steady-state direct-form convolution, with no bounds checks:
+     *   y[k] = \sum_{j=0}^{taps - 1} h[j] x[k + taps - 1 - j],  0 <= k < count
+     * `x` must hold count + taps - 1 samples.
+     *
+     * Outputs are computed four vectors at a time: each tap is broadcast once and multiplied into
+     * four independent accumulators, which hides the multiply-add latency and keeps every load
+     * unit-stride. Leftover outputs go one vector, then one sample, at a time.
+     * @tparam V Instruction set traits providing Scalar, Vector, WIDTH and the static functions
+     *           zero(), broadcast(s), load(p), store(p, v), multiplyAdd(a, b, c) = a * b + c and
+     *           sum(v) (horizontal add of all lanes).
+     */
+    template<typename V>
+    void steadyState(const typename V::Scalar* x, const typename V::Scalar* h, int taps,
+                     typename V::Scalar* y, int count)
+    {
+        using T = typename V::Scalar;
+        constexpr int W = V::WIDTH;
+
+        int k = 0;
+        for (; k + 4 * W <= count; k += 4 * W)
+        {
+            typename V::Vector a0 = V::zero();
+            typename V::Vector a1 = V::zero();
+            typename V::Vector a2 = V::zero();
+            typename V::Vector a3 = V::zero();
+            const T* newest = x + k + taps - 1;
+            for (int j = 0; j < taps; ++j)
+            {
+                const typename V::Vector c = V::broadcast(h[j]);
+                const T* s = newest - j;
+                a0 = V::multiplyAdd(c, V::load(s), a0);
+                a1 = V::multiplyAdd(c, V::load(s + W), a1);
+                a2 = V::multiplyAdd(c, V::load(s + 2 * W), a2);
+                a3 = V::multiplyAdd(c, V::load(s + 3 * W), a3);
+            }
+            V::store(y + k, a0);
+            V::store(y + k + W, a1);
+            V::store(y + k + 2 * W, a2);
+            V::store(y + k + 3 * W, a3);
+        }
+
+        for (; k + W <= count; k += W)
+        {
+            typename V::Vector a = V::zero();
+            const T* newest = x + k + taps - 1;
+            for (int j = 0; j < taps; ++j)
+            {
+                a = V::multiplyAdd(V::broadcast(h[j]), V::load(newest - j), a);
+            }
+            V::store(y + k, a);
+        }
+
+        for (; k < count; ++k)
+        {
+            const T* newest = x + k + taps - 1;
+            T response = 0;
+            for (int j = 0; j < taps; ++j)
+            {
+                response += h[j] * newest[-j];
+            }
+            y[k] = response;
+        }
+    }
+
+    /**
+     * x[newest - p] + x[oldest + p] for symmetric taps, x[newest - p] - x[oldest + p] for antisymmetric ones.
+     */
+    template<typename V, bool ANTISYMMETRIC>
+    inline typename V::Vector fold(typename V::Vector newer, typename V::Vector older)
+    {
+        if constexpr (ANTISYMMETRIC)
+        {
+            return V::subtract(newer, older);
+        }
+        else
+        {
+            return V::add(newer, older);
+        }
+    }
+
+    /**
+     * steadyState for taps with h[taps - 1 - j] = h[j] (or -h[j] if ANTISYMMETRIC), the linear-phase
+     * case. Taps j and taps - 1 - j meet the samples at newest - j and oldest + j, so their two
+     * samples are added (subtracted) first and multiplied once:
+     *   y[k] = \sum_{p < taps / 2} h[p] (x[k + taps - 1 - p] +- x[k + p]) + h[c] x[k + c]
+     * with the centre term c = (taps - 1) / 2 only for odd, symmetric taps (an antisymmetric centre
+     * tap is zero). Only h[0, (taps + 1) / 2) is read. Half the multiplies, and half the broadcasts,
+     * of steadyState; the loads stay the same.
+     * @tparam V Instruction set traits as for steadyState, plus add(a, b) and subtract(a, b).
+     */
+    template<typename V, bool ANTISYMMETRIC>
+    void steadyStateFolded(const typename V::Scalar* x, const typename V::Scalar* h, int taps,
+                           typename V::Scalar* y, int count)
+    {
+        using T = typename V::Scalar;
+        constexpr int W = V::WIDTH;
+        const int pairs = taps / 2;
+        const bool centre = !ANTISYMMETRIC && taps % 2 == 1;
+
+        int k = 0;
+        for (; k + 4 * W <= count; k += 4 * W)
+        {
+            typename V::Vector a0 = V::zero();
+            typename V::Vector a1 = V::zero();
+            typename V::Vector a2 = V::zero();
+            typename V::Vector a3 = V::zero();
+            const T* newest = x + k + taps - 1;
+            const T* oldest = x + k;
+            for (int p = 0; p < pairs; ++p)
+            {
+                const typename V::Vector c = V::broadcast(h[p]);
+                const T* s = newest - p;
+                const T* r = oldest + p;
+                a0 = V::multiplyAdd(c, fold<V, ANTISYMMETRIC>(V::load(s), V::load(r)), a0);
+                a1 = V::multiplyAdd(c, fold<V, ANTISYMMETRIC>(V::load(s + W), V::load(r + W)), a1);
+                a2 = V::multiplyAdd(c, fold<V, ANTISYMMETRIC>(V::load(s + 2 * W), V::load(r + 2 * W)), a2);
+                a3 = V::multiplyAdd(c, fold<V, ANTISYMMETRIC>(V::load(s + 3 * W), V::load(r + 3 * W)), a3);
+            }
+            if (centre)
+            {
+                const typename V::Vector c = V::broadcast(h[pairs]);
+                const T* s = oldest + pairs;
+                a0 = V::multiplyAdd(c, V::load(s), a0);
+                a1 = V::multiplyAdd(c, V::load(s + W), a1);
+                a2 = V::multiplyAdd(c, V::load(s + 2 * W), a2);
+                a3 = V::multiplyAdd(c, V::load(s + 3 * W), a3);
+            }
+            V::store(y + k, a0);
+            V::store(y + k + W, a1);
+            V::store(y + k + 2 * W, a2);
+            V::store(y + k + 3 * W, a3);
+        }
+
+        for (; k + W <= count; k += W)
+        {
+            typename V::Vector a = V::zero();
+            const T* newest = x + k + taps - 1;
+            const T* oldest = x + k;
+            for (int p = 0; p < pairs; ++p)
+            {
+                a = V::multiplyAdd(V::broadcast(h[p]), fold<V, ANTISYMMETRIC>(V::load(newest - p), V::load(oldest + p)), a);
+            }
+            if (centre)
+            {
+                a = V::multiplyAdd(V::broadcast(h[pairs]), V::load(oldest + pairs), a);
+            }
+            V::store(y + k, a);
+        }
+
+        for (; k < count; ++k)
+        {
+            const T* newest = x + k + taps - 1;
+            const T* oldest = x + k;
+            T response = 0;
+            for (int p = 0; p < pairs; ++p)
+            {
+                response += h[p] * (ANTISYMMETRIC ? newest[-p] - oldest[p] : newest[-p] + oldest[p]);
+            }
+            if (centre)
+            {
+                response += h[pairs] * oldest[pairs];
+            }
+            y[k] = response;
+        }
+    }
+
+    /**
+     * Both foldings behind one entry point per instruction set.
+     */
+    template<typename V>
+    void steadyStateFolded(const typename V::Scalar* x, const typename V::Scalar* h, int taps, bool antisymmetric,
+                           typename V::Scalar* y, int count)
+    {
+        if (antisymmetric)
+        {
+            steadyStateFolded<V, true>(x, h, taps, y, count);
+        }
+        else
+        {
+            steadyStateFolded<V, false>(x, h, taps, y, count);
+        }
+    }
+
+    // Outputs per tile of sparseAccumulate: the tile stays in L1 while every tap is added into it
+    constexpr int SPARSE_TILE = 2048;
+
+    /**
+     * Convolution with a sparse impulse response of `taps` (offset, gain) pairs:
+     *   y[i - first] = \sum_t gains[t] x[i - offsets[t]],  first <= i < first + count
+     * with x taken as zero outside [0, n). Offsets must be ascending.
+     *
+     * Rather than gathering the few x samples each output needs, each tap adds gain * x, shifted by
+     * its offset, into a tile of outputs: a unit-stride multiply-add over both arrays, four vectors
+     * at a time. The outputs see their taps in ascending offset order, as convolve1D would.
+     * @tparam V Instruction set traits as for steadyState.
+     */
+    template<typename V>
+    void sparseAccumulate(const typename V::Scalar* x, int n, const int* offsets, const typename V::Scalar* gains,
+                          int taps, typename V::Scalar* y, int first, int count)
+    {
+        using T = typename V::Scalar;
+        constexpr int W = V::WIDTH;
+
+        for (int tileStart = first; tileStart < first + count; tileStart += SPARSE_TILE)
+        {
+            const int tileEnd = tileStart + SPARSE_TILE < first + count ? tileStart + SPARSE_TILE : first + count;
+            T* tile = y + (tileStart - first);
+            for (int i = 0; i < tileEnd - tileStart; ++i)
+            {
+                tile[i] = T(0);
+            }
+
+            for (int t = 0; t < taps; ++t)
+            {
+                // Outputs i of this tile where x[i - offset] exists
+                const int offset = offsets[t];
+                const int begin = tileStart > offset ? tileStart : offset;
+                const int end = tileEnd < offset + n ? tileEnd : offset + n;
+                if (begin >= end)
+                {
+                    continue;
+                }
+                const T gain = gains[t];
+                const typename V::Vector g = V::broadcast(gain);
+                const T* source = x + (begin - offset);
+                T* target = y + (begin - first);
+                const int length = end - begin;
+
+                int i = 0;
+                for (; i + 4 * W <= length; i += 4 * W)
+                {
+                    V::store(target + i, V::multiplyAdd(g, V::load(source + i), V::load(target + i)));
+                    V::store(target + i + W, V::multiplyAdd(g, V::load(source + i + W), V::load(target + i + W)));
+                    V::store(target + i + 2 * W, V::multiplyAdd(g, V::load(source + i + 2 * W), V::load(target + i + 2 * W)));
+                    V::store(target + i + 3 * W, V::multiplyAdd(g, V::load(source + i + 3 * W), V::load(target + i + 3 * W)));
+                }
+                for (; i + W <= length; i += W)
+                {
+                    V::store(target + i, V::multiplyAdd(g, V::load(source + i), V::load(target + i)));
+                }
+                for (; i < length; ++i)
+                {
+                    target[i] += gain * source[i];
+                }
+            }
+        }
+    }
+
+    /**
+     * Inner product \sum_{i=0}^{count - 1} a[i]b[i], with four independent vector accumulators.
+     * @tparam V Instruction set traits, as for steadyState.
+     */
+    template<typename V>
+    typename V::Scalar dot(const typename V::Scalar* a, const typename V::Scalar* b, int count)
+    {
+        using T = typename V::Scalar;
+        constexpr int W = V::WIDTH;
+
+        typename V::Vector a0 = V::zero();
+        typename V::Vector a1 = V::zero();
+        typename V::Vector a2 = V::zero();
+        typename V::Vector a3 = V::zero();
+        int i = 0;
+        for (; i + 4 * W <= count; i += 4 * W)
+        {
+            a0 = V::multiplyAdd(V::load(a + i), V::load(b + i), a0);
+            a1 = V::multiplyAdd(V::load(a + i + W), V::load(b + i + W), a1);
+            a2 = V::multiplyAdd(V::load(a + i + 2 * W), V::load(b + i + 2 * W), a2);
+            a3 = V::multiplyAdd(V::load(a + i + 3 * W), V::load(b + i + 3 * W), a3);
+        }
+        for (; i + W <= count; i += W)
+        {
+            a0 = V::multiplyAdd(V::load(a + i), V::load(b + i), a0);
+        }
+
+        T result = V::sum(a0) + V::sum(a1) + V::sum(a2) + V::sum(a3);
+        for (; i < count; ++i)
+        {
+            result += a[i] * b[i];
+        }
+        return result;
+    }
+
+    // One entry point per instruction set, each defined in kernels_<isa>.cpp.
+    // Only call a kernel after checking the host supports its instruction set.
+    void steadyStateSse2(const float* x, const float* h, int taps, float* y, int count);
+    void steadyStateSse2(const double* x, const double* h, int taps, double* y, int count);
+    float dotSse2(const float* a, const float* b, int count);
+    double dotSse2(const double* a, const double* b, int count);
+    void steadyStateFoldedSse2(const float* x, const float* h, int taps, bool antisymmetric, float* y, int count);
+    void steadyStateFoldedSse2(const double* x, const double* h, int taps, bool antisymmetric, double* y, int count);
+    void sparseAccumulateSse2(const float* x, int n, const int* offsets, const float* gains, int taps, float* y, int first, int count);
+    void sparseAccumulateSse2(const double* x, int n, const int* offsets, const double* gains, int taps, double* y, int first, int count);
+    void steadyStateAvx2(const float* x, const float* h, int taps, float* y, int count);
+    void steadyStateAvx2(const double* x, const double* h, int taps, double* y, int count);
+    float dotAvx2(const float* a, const float* b, int count);
+    double dotAvx2(const double* a, const double* b, int count);
+    void steadyStateFoldedAvx2(const float* x, const float* h, int taps, bool antisymmetric, float* y, int count);
+    void steadyStateFoldedAvx2(const double* x, const double* h, int taps, bool antisymmetric, double* y, int count);
+    void sparseAccumulateAvx2(const float* x, int n, const int* offsets, const float* gains, int taps, float* y, int first, int count);
+    void sparseAccumulateAvx2(const double* x, int n, const int* offsets, const double* gains, int taps, double* y, int first, int count);
+    void steadyStateAvx512(const float* x, const float* h, int taps, float* y, int count);
+    void steadyStateAvx512(const double* x, const double* h, int taps, double* y, int count);
+    float dotAvx512(const float* a, const float* b, int count);
+    double dotAvx512(const double* a, const double* b, int count);
+    void steadyStateFoldedAvx512(const float* x, const float* h, int taps, bool antisymmetric, float* y, int count);
+    void steadyStateFoldedAvx512(const double* x, const double* h, int taps, bool antisymmetric, double* y, int count);
+    void sparseAccumulateAvx512(const float* x, int n, const int* offsets, const float* gains, int taps, float* y, int first, int count);
+    void sparseAccumulateAvx512(const double* x, int n, const int* offsets, const double* gains, int taps, double* y, int first, int count);
+    void steadyStateNeon(const float* x, const float* h, int taps, float* y, int count);
+    void steadyStateNeon(const double* x, const double* h, int taps, double* y, int count);
+    float dotNeon(const float* a, const float* b, int count);
+    double dotNeon(const double* a, const double* b, int count);
+    void steadyStateFoldedNeon(const float* x, const float* h, int taps, bool antisymmetric, float* y, int count);
+    void steadyStateFoldedNeon(const double* x, const double* h, int taps, bool antisymmetric, double* y, int count);
+    void sparseAccumulateNeon(const float* x, int n, const int* offsets, const float* gains, int taps, float* y, int first, int count);
+    void sparseAccumulateNeon(const double* x, int n, const int* offsets, const double* gains, int taps, double* y, int first, int count);
+}
+
+#endif //SIGNAL_PROCESSING_BOOK_DIRECT_KERNELS_H
@@ -0,0 +1,107 @@
+#ifndef SIGNAL_PROCESSING_BOOK_FIXED_POINT_KERNELS_H
+#define SIGNAL_PROCESSING_BOOK_FIXED_POINT_KERNELS_H
+
+// Private to libdsp, and like direct_kernels.h free of standard library includes.
+
+namespace dsp::signals::simd
+{
+    // The scalar helpers below are static: they are emitted by the ISA files as well as the baseline
+    // fixed_point_convolution.cpp, and each must keep its own copy (see direct_kernels.h).
+
+    /**
+     * Rounds a Q30 sum of Q15 products back to Q15, saturating to the int16 range.
+     */
+    static inline short roundQ15(int accumulator)
+    {
+        const int result = (accumulator + (1 << 14)) >> 15;
+        return static_cast<short>(result > 32767 ? 32767 : (result < -32768 ? -32768 : result));
+    }
+
+    /**
+     * h0 * (low 16 bits of a) + h1 * (high 16 bits of a), for a pair packed as in steadyStateQ15.
+     */
+    static inline int multiplyPair(int a, int pair)
+    {
+        return static_cast<short>(a & 0xffff) * static_cast<short>(pair & 0xffff) + (a >> 16) * (pair >> 16);
+    }
+
+    /**
+     * Steady-state Q15 direct-form convolution, with no bounds checks:
+     *   y[k] = round(\sum_{j=0}^{taps - 1} h[j] x[k + taps - 1 - j] / 2^15),  0 <= k < count
+     *
+     * Both operands come packed two 16-bit values to a 32-bit word, the layout the integer pairwise
+     * multiply-add instructions (pmaddwd) want:
+     *  - pairs[p] holds h[2p] in its low and h[2p + 1] in its high half (0 past the last tap)
+     *  - x2[i] holds x[i] in its low and x[i - 1] in its high half, for 0 <= i < count + taps - 1
+     * so taps 2p and 2p + 1 of output k are a single product of pairs[p] with x2[k + taps - 1 - 2p],
+     * and consecutive outputs read consecutive words. Outputs are computed four vectors at a time,
+     * as in steadyState.
+     *
+     * Sums are kept in 32 bits, so the caller must make sure they can't overflow: that holds
+     * whenever \sum |h[j]| <= 65535.
+     * @tparam V Instruction set traits providing WIDTH (outputs per vector), Vector, Coefficient,
+     *           Accumulator and the static functions zero(), broadcast(pair), load(p),
+     *           multiplyAdd(x, c, a), which adds the pair products of x and c to a, and
+     *           store(y, a), which rounds, saturates and writes WIDTH outputs.
+     */
+    template<typename V>
+    void steadyStateQ15(const int* x2, const int* pairs, int taps, short* y, int count)
+    {
+        constexpr int W = V::WIDTH;
+        const int pairCount = (taps + 1) / 2;
+
+        int k = 0;
+        for (; k + 4 * W <= count; k += 4 * W)
+        {
+            typename V::Accumulator a0 = V::zero();
+            typename V::Accumulator a1 = V::zero();
+            typename V::Accumulator a2 = V::zero();
+            typename V::Accumulator a3 = V::zero();
+            const int* newest = x2 + k + taps - 1;
+            for (int p = 0; p < pairCount; ++p)
+            {
+                const typename V::Coefficient c = V::broadcast(pairs[p]);
+                const int* s = newest - 2 * p;
+                a0 = V::multiplyAdd(V::load(s), c, a0);
+                a1 = V::multiplyAdd(V::load(s + W), c, a1);
+                a2 = V::multiplyAdd(V::load(s + 2 * W), c, a2);
+                a3 = V::multiplyAdd(V::load(s + 3 * W), c, a3);
+            }
+            V::store(y + k, a0);
+            V::store(y + k + W, a1);
+            V::store(y + k + 2 * W, a2);
+            V::store(y + k + 3 * W, a3);
+        }
+
+        for (; k + W <= count; k += W)
+        {
+            typename V::Accumulator a = V::zero();
+            const int* newest = x2 + k + taps - 1;
+            for (int p = 0; p < pairCount; ++p)
+            {
+                a = V::multiplyAdd(V::load(newest - 2 * p), V::broadcast(pairs[p]), a);
+            }
+            V::store(y + k, a);
+        }
+
+        for (; k < count; ++k)
+        {
+            const int* newest = x2 + k + taps - 1;
+            int accumulator = 0;
+            for (int p = 0; p < pairCount; ++p)
+            {
+                accumulator += multiplyPair(newest[-2 * p], pairs[p]);
+            }
+            y[k] = roundQ15(accumulator);
+        }
+    }
+
+    // One entry point per instruction set, each defined in kernels_<isa>.cpp.
+    // Only call a kernel after checking the host supports its instruction set.
+    void steadyStateQ15Sse2(const int* x2, const int* pairs, int taps, short* y, int count);
+    void steadyStateQ15Avx2(const int* x2, const int* pairs, int taps, short* y, int count);
+    void steadyStateQ15Avx512(const int* x2, const int* pairs, int taps, short* y, int count);
+    void steadyStateQ15Neon(const int* x2, const int* pairs, int taps, short* y, int count);
+}
+
+#endif //SIGNAL_PROCESSING_BOOK_FIXED_POINT_KERNELS_H
@@ -0,0 +1,125 @@
+#include "biquad_kernels.h"
+#include "direct_kernels.h"
+#include "fixed_point_kernels.h"
+
+#include <immintrin.h>
+
+// Compiled with AVX2 + FMA enabled (-mavx2 -mfma, or /arch:AVX2 on MSVC).
+namespace dsp::signals::simd
+{
+    namespace
+    {
+        struct Avx2Float
+        {
+            using Scalar = float;
+            using Vector = __m256;
+            static constexpr int WIDTH = 8;
+            static Vector zero() { return _mm256_setzero_ps(); }
+            static Vector broadcast(float s) { return _mm256_set1_ps(s); }
+            static Vector load(const float* p) { return _mm256_loadu_ps(p); }
+            static void store(float* p, Vector v) { _mm256_storeu_ps(p, v); }
+            static Vector multiplyAdd(Vector a, Vector b, Vector c) { return _mm256_fmadd_ps(a, b, c); }
+            static Vector add(Vector a, Vector b) { return _mm256_add_ps(a, b); }
+            static Vector subtract(Vector a, Vector b) { return _mm256_sub_ps(a, b); }
+            static float sum(Vector v)
+            {
+                const __m128 half = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+                const __m128 pair = _mm_add_ps(half, _mm_movehl_ps(half, half));
+                return _mm_cvtss_f32(_mm_add_ss(pair, _mm_shuffle_ps(pair, pair, 1)));
+            }
+        };
+
+        struct Avx2Double
+        {
+            using Scalar = double;
+            using Vector = __m256d;
+            static constexpr int WIDTH = 4;
+            static Vector zero() { return _mm256_setzero_pd(); }
+            static Vector broadcast(double s) { return _mm256_set1_pd(s); }
+            static Vector load(const double* p) { return _mm256_loadu_pd(p); }
+            static void store(double* p, Vector v) { _mm256_storeu_pd(p, v); }
+            static Vector multiplyAdd(Vector a, Vector b, Vector c) { return _mm256_fmadd_pd(a, b, c); }
+            static Vector add(Vector a, Vector b) { return _mm256_add_pd(a, b); }
+            static Vector subtract(Vector a, Vector b) { return _mm256_sub_pd(a, b); }
+            static double sum(Vector v)
+            {
+                const __m128d half = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+                return _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+            }
+        };
+
+        struct Avx2Q15
+        {
+            using Vector = __m256i;
+            using Coefficient = __m256i;
+            using Accumulator = __m256i;
+            static constexpr int WIDTH = 8;
+            static Accumulator zero() { return _mm256_setzero_si256(); }
+            static Coefficient broadcast(int pair) { return _mm256_set1_epi32(pair); }
+            static Vector load(const int* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+            static Accumulator multiplyAdd(Vector x, Coefficient c, Accumulator a) { return _mm256_add_epi32(a, _mm256_madd_epi16(x, c)); }
+            static void store(short* y, Accumulator a)
+            {
+                // packs works per 128-bit half; gather the two halves' low quadwords back together
+                const __m256i rounded = _mm256_srai_epi32(_mm256_add_epi32(a, _mm256_set1_epi32(1 << 14)), 15);
+                const __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(rounded, rounded), 0x08);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(y), _mm256_castsi256_si128(packed));
+            }
+        };
+    }
+
+    void steadyStateAvx2(const float* x, const float* h, int taps, float* y, int count)
+    {
+        steadyState<Avx2Float>(x, h, taps, y, count);
+    }
+
+    void steadyStateAvx2(const double* x, const double* h, int taps, double* y, int count)
+    {
+        steadyState<Avx2Double>(x, h, taps, y, count);
+    }
+
+    float dotAvx2(const float* a, const float* b, int count)
+    {
+        return dot<Avx2Float>(a, b, count);
+    }
+
+    double dotAvx2(const double* a, const double* b, int count)
+    {
+        return dot<Avx2Double>(a, b, count);
+    }
+
+    void steadyStateFoldedAvx2(const float* x, const float* h, int taps, bool antisymmetric, float* y, int count)
+    {
+        steadyStateFolded<Avx2Float>(x, h, taps, antisymmetric, y, count);
+    }
+
+    void steadyStateFoldedAvx2(const double* x, const double* h, int taps, bool antisymmetric, double* y, int count)
+    {
+        steadyStateFolded<Avx2Double>(x, h, taps, antisymmetric, y, count);
+    }
+
+    void sparseAccumulateAvx2(const float* x, int n, const int* offsets, const float* gains, int taps, float* y, int first, int count)
+    {
+        sparseAccumulate<Avx2Float>(x, n, offsets, gains, taps, y, first, count);
+    }
+
+    void sparseAccumulateAvx2(const double* x, int n, const int* offsets, const double* gains, int taps, double* y, int first, int count)
+    {
+        sparseAccumulate<Avx2Double>(x, n, offsets, gains, taps, y, first, count);
+    }
+
+    void steadyStateQ15Avx2(const int* x2, const int* pairs, int taps, short* y, int count)
+    {
+        steadyStateQ15<Avx2Q15>(x2, pairs, taps, y, count);
+    }
+
+    void biquadCascadeAvx2(const float* coefficients, int sections, float* state, const float* in, float* out, int frames, int channels)
+    {
+        biquadCascade<Avx2Float>(coefficients, sections, state, in, out, frames, channels);
+    }
+
+    void biquadCascadeAvx2(const double* coefficients, int sections, double* state, const double* in, double* out, int frames, int channels)
+    {
+        biquadCascade<Avx2Double>(coefficients, sections, state, in, out, frames, channels);
+    }
+}
@@ -0,0 +1,116 @@
+#include "biquad_kernels.h"
+#include "direct_kernels.h"
+
+#include <immintrin.h>
+
+// Compiled with AVX-512F enabled (-mavx512f, or /arch:AVX512 on MSVC).
+namespace dsp::signals::simd
+{
+    namespace
+    {
+        struct Avx512Float
+        {
+            using Scalar = float;
+            using Vector = __m512;
+            static constexpr int WIDTH = 16;
+            static Vector zero() { return _mm512_setzero_ps(); }
+            static Vector broadcast(float s) { return _mm512_set1_ps(s); }
+            static Vector load(const float* p) { return _mm512_loadu_ps(p); }
+            static void store(float* p, Vector v) { _mm512_storeu_ps(p, v); }
+            static Vector multiplyAdd(Vector a, Vector b, Vector c) { return _mm512_fmadd_ps(a, b, c); }
+            static Vector add(Vector a, Vector b) { return _mm512_add_ps(a, b); }
+            static Vector subtract(Vector a, Vector b) { return _mm512_sub_ps(a, b); }
+            static float sum(Vector v)
+            {
+                // Once per dot product, so a store and a scalar pairwise sum are plenty
+                alignas(64) float lanes[WIDTH];
+                _mm512_store_ps(lanes, v);
+                for (int width = WIDTH / 2; width > 0; width /= 2)
+                {
+                    for (int i = 0; i < width; ++i)
+                    {
+                        lanes[i] += lanes[i + width];
+                    }
+                }
+                return lanes[0];
+            }
+        };
+
+        struct Avx512Double
+        {
+            using Scalar = double;
+            using Vector = __m512d;
+            static constexpr int WIDTH = 8;
+            static Vector zero() { return _mm512_setzero_pd(); }
+            static Vector broadcast(double s) { return _mm512_set1_pd(s); }
+            static Vector load(const double* p) { return _mm512_loadu_pd(p); }
+            static void store(double* p, Vector v) { _mm512_storeu_pd(p, v); }
+            static Vector multiplyAdd(Vector a, Vector b, Vector c) { return _mm512_fmadd_pd(a, b, c); }
+            static Vector add(Vector a, Vector b) { return _mm512_add_pd(a, b); }
+            static Vector subtract(Vector a, Vector b) { return _mm512_sub_pd(a, b); }
+            static double sum(Vector v)
+            {
+                alignas(64) double lanes[WIDTH];
+                _mm512_store_pd(lanes, v);
+                for (int width = WIDTH / 2; width > 0; width /= 2)
+                {
+                    for (int i = 0; i < width; ++i)
+                    {
+                        lanes[i] += lanes[i + width];
+                    }
+                }
+                return lanes[0];
+            }
+        };
+    }
+
+    void steadyStateAvx512(const float* x, const float* h, int taps, float* y, int count)
+    {
+        steadyState<Avx512Float>(x, h, taps, y, count);
+    }
+
+    void steadyStateAvx512(const double* x, const double* h, int taps, double* y, int count)
+    {
+        steadyState<Avx512Double>(x, h, taps, y, count);
+    }
+
+    float dotAvx512(const float* a, const float* b, int count)
+    {
+        return dot<Avx512Float>(a, b, count);
+    }
+
+    double dotAvx512(const double* a, const double* b, int count)
+    {
+        return dot<Avx512Double>(a, b, count);
+    }
+
+    void steadyStateFoldedAvx512(const float* x, const float* h, int taps, bool antisymmetric, float* y, int count)
+    {
+        steadyStateFolded<Avx512Float>(x, h, taps, antisymmetric, y, count);
+    }
+
+    void steadyStateFoldedAvx512(const double* x, const double* h, int taps, bool antisymmetric, double* y, int count)
+    {
+        steadyStateFolded<Avx512Double>(x, h, taps, antisymmetric, y, count);
+    }
+
+    void sparseAccumulateAvx512(const float* x, int n, const int* offsets, const float* gains, int taps, float* y, int first, int count)
+    {
+        sparseAccumulate<Avx512Float>(x, n, offsets, gains, taps, y, first, count);
+    }
+
+    void sparseAccumulateAvx512(const double* x, int n, const int* offsets, const double* gains, int taps, double* y, int first, int count)
+    {
+        sparseAccumulate<Avx512Double>(x, n, offsets, gains, taps, y, first, count);
+    }
+
+    void biquadCascadeAvx512(const float* coefficients, int sections, float* state, const float* in, float* out, int frames, int channels)
+    {
+        biquadCascade<Avx512Float>(coefficients, sections, state, in, out, frames, channels);
+    }
+
+    void biquadCascadeAvx512(const double* coefficients, int sections, double* state, const double* in, double* out, int frames, int channels)
+    {
+        biquadCascade<Avx512Double>(coefficients, sections, state, in, out, frames, channels);
+    }
+}
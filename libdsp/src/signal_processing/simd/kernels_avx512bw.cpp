@@ -0,0 +1,35 @@
+#include "fixed_point_kernels.h"
+
+#include <immintrin.h>
+
+// Compiled with AVX-512F and AVX-512BW enabled (-mavx512f -mavx512bw, or /arch:AVX512 on MSVC).
+// The 16-bit integer instructions live in BW, which kernels_avx512.cpp does not assume.
+namespace dsp::signals::simd
+{
+    namespace
+    {
+        struct Avx512Q15
+        {
+            using Vector = __m512i;
+            using Coefficient = __m512i;
+            using Accumulator = __m512i;
+            static constexpr int WIDTH = 16;
+            static Accumulator zero() { return _mm512_setzero_si512(); }
+            static Coefficient broadcast(int pair) { return _mm512_set1_epi32(pair); }
+            static Vector load(const int* p) { return _mm512_loadu_si512(p); }
+            static Accumulator multiplyAdd(Vector x, Coefficient c, Accumulator a) { return _mm512_add_epi32(a, _mm512_madd_epi16(x, c)); }
+            static void store(short* y, Accumulator a)
+            {
+                // Zero-masked forms of the shift and saturating narrow, since GCC 12 warns about the
+                // undefined pass-through operand of the unmasked ones
+                const __m512i rounded = _mm512_maskz_srai_epi32(0xffff, _mm512_add_epi32(a, _mm512_set1_epi32(1 << 14)), 15);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(y), _mm512_maskz_cvtsepi32_epi16(0xffff, rounded));
+            }
+        };
+    }
+
+    void steadyStateQ15Avx512(const int* x2, const int* pairs, int taps, short* y, int count)
+    {
+        steadyStateQ15<Avx512Q15>(x2, pairs, taps, y, count);
+    }
+}
@@ -0,0 +1,124 @@
+#include "biquad_kernels.h"
+#include "direct_kernels.h"
+#include "fixed_point_kernels.h"
+
+#include <arm_neon.h>
+
+// AArch64 only: Advanced SIMD is always available there, including the double precision lanes.
+namespace dsp::signals::simd
+{
+    namespace
+    {
+        struct NeonFloat
+        {
+            using Scalar = float;
+            using Vector = float32x4_t;
+            static constexpr int WIDTH = 4;
+            static Vector zero() { return vdupq_n_f32(0.0f); }
+            static Vector broadcast(float s) { return vdupq_n_f32(s); }
+            static Vector load(const float* p) { return vld1q_f32(p); }
+            static void store(float* p, Vector v) { vst1q_f32(p, v); }
+            static Vector multiplyAdd(Vector a, Vector b, Vector c) { return vfmaq_f32(c, a, b); }
+            static Vector add(Vector a, Vector b) { return vaddq_f32(a, b); }
+            static Vector subtract(Vector a, Vector b) { return vsubq_f32(a, b); }
+            static float sum(Vector v) { return vaddvq_f32(v); }
+        };
+
+        struct NeonDouble
+        {
+            using Scalar = double;
+            using Vector = float64x2_t;
+            static constexpr int WIDTH = 2;
+            static Vector zero() { return vdupq_n_f64(0.0); }
+            static Vector broadcast(double s) { return vdupq_n_f64(s); }
+            static Vector load(const double* p) { return vld1q_f64(p); }
+            static void store(double* p, Vector v) { vst1q_f64(p, v); }
+            static Vector multiplyAdd(Vector a, Vector b, Vector c) { return vfmaq_f64(c, a, b); }
+            static Vector add(Vector a, Vector b) { return vaddq_f64(a, b); }
+            static Vector subtract(Vector a, Vector b) { return vsubq_f64(a, b); }
+            static double sum(Vector v) { return vaddvq_f64(v); }
+        };
+
+        struct NeonQ15
+        {
+            // No pairwise 16-bit multiply-add: deinterleave the pairs on load and widen-multiply each half
+            struct Accumulator
+            {
+                int32x4_t lo;
+                int32x4_t hi;
+            };
+            using Vector = int16x8x2_t;
+            using Coefficient = int16x4_t;
+            static constexpr int WIDTH = 8;
+            static Accumulator zero() { return {vdupq_n_s32(0), vdupq_n_s32(0)}; }
+            static Coefficient broadcast(int pair) { return vreinterpret_s16_s32(vdup_n_s32(pair)); }
+            static Vector load(const int* p) { return vld2q_s16(reinterpret_cast<const short*>(p)); }
+            static Accumulator multiplyAdd(Vector x, Coefficient c, Accumulator a)
+            {
+                a.lo = vmlal_lane_s16(vmlal_lane_s16(a.lo, vget_low_s16(x.val[0]), c, 0), vget_low_s16(x.val[1]), c, 1);
+                a.hi = vmlal_lane_s16(vmlal_lane_s16(a.hi, vget_high_s16(x.val[0]), c, 0), vget_high_s16(x.val[1]), c, 1);
+                return a;
+            }
+            static void store(short* y, Accumulator a)
+            {
+                // Rounding, saturating narrow: exactly roundQ15
+                vst1q_s16(y, vcombine_s16(vqrshrn_n_s32(a.lo, 15), vqrshrn_n_s32(a.hi, 15)));
+            }
+        };
+    }
+
+    void steadyStateNeon(const float* x, const float* h, int taps, float* y, int count)
+    {
+        steadyState<NeonFloat>(x, h, taps, y, count);
+    }
+
+    void steadyStateNeon(const double* x, const double* h, int taps, double* y, int count)
+    {
+        steadyState<NeonDouble>(x, h, taps, y, count);
+    }
+
+    float dotNeon(const float* a, const float* b, int count)
+    {
+        return dot<NeonFloat>(a, b, count);
+    }
+
+    double dotNeon(const double* a, const double* b, int count)
+    {
+        return dot<NeonDouble>(a, b, count);
+    }
+
+    void steadyStateFoldedNeon(const float* x, const float* h, int taps, bool antisymmetric, float* y, int count)
+    {
+        steadyStateFolded<NeonFloat>(x, h, taps, antisymmetric, y, count);
+    }
+
+    void steadyStateFoldedNeon(const double* x, const double* h, int taps, bool antisymmetric, double* y, int count)
+    {
+        steadyStateFolded<NeonDouble>(x, h, taps, antisymmetric, y, count);
+    }
+
+    void sparseAccumulateNeon(const float* x, int n, const int* offsets, const float* gains, int taps, float* y, int first, int count)
+    {
+        sparseAccumulate<NeonFloat>(x, n, offsets, gains, taps, y, first, count);
+    }
+
+    void sparseAccumulateNeon(const double* x, int n, const int* offsets, const double* gains, int taps, double* y, int first, int count)
+    {
+        sparseAccumulate<NeonDouble>(x, n, offsets, gains, taps, y, first, count);
+    }
+
+    void steadyStateQ15Neon(const int* x2, const int* pairs, int taps, short* y, int count)
+    {
+        steadyStateQ15<NeonQ15>(x2, pairs, taps, y, count);
+    }
+
+    void biquadCascadeNeon(const float* coefficients, int sections, float* state, const float* in, float* out, int frames, int channels)
+    {
+        biquadCascade<NeonFloat>(coefficients, sections, state, in, out, frames, channels);
+    }
+
+    void biquadCascadeNeon(const double* coefficients, int sections, double* state, const double* in, double* out, int frames, int channels)
+    {
+        biquadCascade<NeonDouble>(coefficients, sections, state, in, out, frames, channels);
+    }
+}
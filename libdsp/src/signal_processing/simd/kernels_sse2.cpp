@@ -0,0 +1,124 @@
+#include "biquad_kernels.h"
+#include "direct_kernels.h"
+#include "fixed_point_kernels.h"
+
+#include <emmintrin.h>
+
+// SSE2 has no fused multiply-add, so multiplyAdd is a separate multiply and add.
+namespace dsp::signals::simd
+{
+    namespace
+    {
+        struct Sse2Float
+        {
+            using Scalar = float;
+            using Vector = __m128;
+            static constexpr int WIDTH = 4;
+            static Vector zero() { return _mm_setzero_ps(); }
+            static Vector broadcast(float s) { return _mm_set1_ps(s); }
+            static Vector load(const float* p) { return _mm_loadu_ps(p); }
+            static void store(float* p, Vector v) { _mm_storeu_ps(p, v); }
+            static Vector multiplyAdd(Vector a, Vector b, Vector c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+            static Vector add(Vector a, Vector b) { return _mm_add_ps(a, b); }
+            static Vector subtract(Vector a, Vector b) { return _mm_sub_ps(a, b); }
+            static float sum(Vector v)
+            {
+                alignas(16) float lanes[WIDTH];
+                _mm_store_ps(lanes, v);
+                return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+            }
+        };
+
+        struct Sse2Double
+        {
+            using Scalar = double;
+            using Vector = __m128d;
+            static constexpr int WIDTH = 2;
+            static Vector zero() { return _mm_setzero_pd(); }
+            static Vector broadcast(double s) { return _mm_set1_pd(s); }
+            static Vector load(const double* p) { return _mm_loadu_pd(p); }
+            static void store(double* p, Vector v) { _mm_storeu_pd(p, v); }
+            static Vector multiplyAdd(Vector a, Vector b, Vector c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+            static Vector add(Vector a, Vector b) { return _mm_add_pd(a, b); }
+            static Vector subtract(Vector a, Vector b) { return _mm_sub_pd(a, b); }
+            static double sum(Vector v)
+            {
+                alignas(16) double lanes[WIDTH];
+                _mm_store_pd(lanes, v);
+                return lanes[0] + lanes[1];
+            }
+        };
+
+        struct Sse2Q15
+        {
+            using Vector = __m128i;
+            using Coefficient = __m128i;
+            using Accumulator = __m128i;
+            static constexpr int WIDTH = 4;
+            static Accumulator zero() { return _mm_setzero_si128(); }
+            static Coefficient broadcast(int pair) { return _mm_set1_epi32(pair); }
+            static Vector load(const int* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+            static Accumulator multiplyAdd(Vector x, Coefficient c, Accumulator a) { return _mm_add_epi32(a, _mm_madd_epi16(x, c)); }
+            static void store(short* y, Accumulator a)
+            {
+                const __m128i rounded = _mm_srai_epi32(_mm_add_epi32(a, _mm_set1_epi32(1 << 14)), 15);
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(y), _mm_packs_epi32(rounded, rounded));
+            }
+        };
+    }
+
+    void steadyStateSse2(const float* x, const float* h, int taps, float* y, int count)
+    {
+        steadyState<Sse2Float>(x, h, taps, y, count);
+    }
+
+    void steadyStateSse2(const double* x, const double* h, int taps, double* y, int count)
+    {
+        steadyState<Sse2Double>(x, h, taps, y, count);
+    }
+
+    float dotSse2(const float* a, const float* b, int count)
+    {
+        return dot<Sse2Float>(a, b, count);
+    }
+
+    double dotSse2(const double* a, const double* b, int count)
+    {
+        return dot<Sse2Double>(a, b, count);
+    }
+
+    void steadyStateFoldedSse2(const float* x, const float* h, int taps, bool antisymmetric, float* y, int count)
+    {
+        steadyStateFolded<Sse2Float>(x, h, taps, antisymmetric, y, count);
+    }
+
+    void steadyStateFoldedSse2(const double* x, const double* h, int taps, bool antisymmetric, double* y, int count)
+    {
+        steadyStateFolded<Sse2Double>(x, h, taps, antisymmetric, y, count);
+    }
+
+    void sparseAccumulateSse2(const float* x, int n, const int* offsets, const float* gains, int taps, float* y, int first, int count)
+    {
+        sparseAccumulate<Sse2Float>(x, n, offsets, gains, taps, y, first, count);
+    }
+
+    void sparseAccumulateSse2(const double* x, int n, const int* offsets, const double* gains, int taps, double* y, int first, int count)
+    {
+        sparseAccumulate<Sse2Double>(x, n, offsets, gains, taps, y, first, count);
+    }
+
+    void steadyStateQ15Sse2(const int* x2, const int* pairs, int taps, short* y, int count)
+    {
+        steadyStateQ15<Sse2Q15>(x2, pairs, taps, y, count);
+    }
+
+    void biquadCascadeSse2(const float* coefficients, int sections, float* state, const float* in, float* out, int frames, int channels)
+    {
+        biquadCascade<Sse2Float>(coefficients, sections, state, in, out, frames, channels);
+    }
+
+    void biquadCascadeSse2(const double* coefficients, int sections, double* state, const double* in, double* out, int frames, int channels)
+    {
+        biquadCascade<Sse2Double>(coefficients, sections, state, in, out, frames, channels);
+    }
+}
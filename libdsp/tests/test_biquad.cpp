@@ -0,0 +1,104 @@
+#include "test_helpers.h"
+
+#include "libdsp/signal_processing/biquad.h"
+#include "libdsp/signal_processing/iir_design.h"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// BiquadCascade at every SIMD level and channel count, against a scalar transposed direct-form II
+// reference in double precision.
+
+namespace
+{
+    using namespace dsp;
+
+    constexpr int FRAMES = 700;
+
+    /**
+     * y = b0 x + s1,  s1 = b1 x - a1 y + s2,  s2 = b2 x - a2 y, section by section, per channel.
+     */
+    template<std::floating_point T>
+    std::vector<double> reference(const std::vector<signals::Biquad<T>>& sections, const std::vector<T>& x, int channels)
+    {
+        std::vector<double> y(x.begin(), x.end());
+        for (const signals::Biquad<T>& s : sections)
+        {
+            for (int c = 0; c < channels; ++c)
+            {
+                double s1 = 0.0;
+                double s2 = 0.0;
+                for (int f = 0; f < FRAMES; ++f)
+                {
+                    double& sample = y[static_cast<size_t>(f) * channels + c];
+                    const double in = sample;
+                    const double out = s.b0 * in + s1;
+                    s1 = s.b1 * in - s.a1 * out + s2;
+                    s2 = s.b2 * in - s.a2 * out;
+                    sample = out;
+                }
+            }
+        }
+        return y;
+    }
+
+    template<std::floating_point T>
+    void testCascade(const std::string& level)
+    {
+        std::vector<signals::Biquad<T>> sections = signals::butterworthLowpass<T>(6, 0.1);
+        sections.push_back(signals::notch<T>(0.05, 4.0));
+        const std::vector<signals::Biquad<T>> highpass = signals::chebyshevHighpass<T>(3, 0.5, 0.2);
+        sections.insert(sections.end(), highpass.begin(), highpass.end());
+        const double tolerance = std::is_same_v<T, float> ? 1e-5 : 1e-13;
+
+        // Channel counts around every vector width and group of four vectors, and the scalar tail
+        for (int channels : {1, 3, 4, 8, 13, 16, 37, 64})
+        {
+            const std::vector<T> x = test::randomSignal<T>(FRAMES * channels, channels);
+            const std::vector<double> expected = reference(sections, x, channels);
+            const std::string name = "BiquadCascade " + level + " " + std::to_string(channels) + " channels";
+
+            signals::BiquadCascade<T> cascade(sections, channels);
+            std::vector<T> y(x.size());
+            test::forEachChunk(FRAMES, [&](int offset, int count) {
+                cascade.process(x.data() + static_cast<size_t>(offset) * channels, y.data() + static_cast<size_t>(offset) * channels, count);
+            });
+            test::checkClose(y, expected, tolerance, name);
+
+            // In place, after a reset
+            cascade.reset();
+            std::vector<T> inPlace = x;
+            cascade.process(inPlace.data(), inPlace.data(), FRAMES);
+            test::checkClose(inPlace, expected, tolerance, name + " in place");
+        }
+    }
+
+    void testShapeChecks()
+    {
+        const std::vector<signals::Biquad<float>> sections = signals::butterworthLowpass<float>(2, 0.1);
+        signals::BiquadCascade<float> cascade(sections, 3);
+        StaticBuffer<float, 8> input{};
+        StaticBuffer<float, 8> output{};
+        bool threw = false;
+        try
+        {
+            cascade.process(input, output);
+        }
+        catch (const std::invalid_argument&)
+        {
+            threw = true;
+        }
+        test::check(threw, "BiquadCascade rejects a buffer that isn't whole frames");
+    }
+}
+
+int main()
+{
+    dsp::test::forEachSimdLevel([](const std::string& level) {
+        testCascade<float>(level);
+        testCascade<double>(level);
+    });
+    testShapeChecks();
+    return dsp::test::finish("test_biquad");
+}
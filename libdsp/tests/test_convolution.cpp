@@ -0,0 +1,394 @@
+#include "test_helpers.h"
+
+#include "libdsp/signal_processing/batch_convolution.h"
+#include "libdsp/signal_processing/constexpr_fir.h"
+#include "libdsp/signal_processing/convolution_planner.h"
+#include "libdsp/signal_processing/parallel_convolution.h"
+#include "libdsp/signal_processing/sparse_impulse_response.h"
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// The whole-signal convolution front-ends against convolve1D.
+
+namespace
+{
+    using namespace dsp;
+
+    template<std::floating_point T>
+    double tolerance()
+    {
+        return std::is_same_v<T, float> ? 1e-6 : 1e-14;
+    }
+
+    /**
+     * ConstexprFir<Taps> over N samples against convolve1D, in full and over the valid outputs.
+     */
+    template<auto Taps, int N>
+    void checkConstexprFir(const std::string& name)
+    {
+        using T = typename decltype(Taps)::value_type;
+        constexpr int M = static_cast<int>(Taps.size());
+        const std::vector<T> x = test::randomSignal<T>(N, N);
+        const std::vector<T> expected = test::referenceConvolution<N, M>(std::span<const T>(x), std::span<const T>(Taps));
+
+        auto bx = std::make_unique<StaticBuffer<T, N>>();
+        std::copy(x.begin(), x.end(), bx->_data.begin());
+        const auto y = std::make_unique<StaticBuffer<T, N + M - 1>>(signals::convolve1D<Taps>(*bx));
+        const std::string label = "ConstexprFir " + name + " n " + std::to_string(N);
+        test::checkClose(std::span<const T>(y->_data), std::span<const T>(expected), tolerance<T>(), label);
+
+        if constexpr (N >= M)
+        {
+            std::vector<T> valid(N - M + 1);
+            signals::ConstexprFir<Taps>::convolveValid(x.data(), N, valid.data());
+            test::checkClose(valid, std::vector<T>(expected.begin() + M - 1, expected.begin() + N), tolerance<T>(), label + " valid");
+        }
+    }
+
+    void testConstexprFir()
+    {
+        // Zero taps are dropped, +1 / -1 taps become an add / subtract, the rest are multiplies
+        static constexpr std::array MIXED{0.0, 0.5, -0.2, 1.0, -1.0};
+        static constexpr std::array MIXED_FLOAT{0.0f, 0.5f, -0.2f, 1.0f, -1.0f};
+        static constexpr std::array UNIT{1.0, -1.0, 1.0};
+        static constexpr std::array ZEROS{0.0, 0.0, 0.0};
+        static constexpr std::array SINGLE{-1.0};
+        static_assert(signals::ConstexprFir<MIXED>::ACTIVE_TAP_COUNT == 4);
+        static_assert(signals::ConstexprFir<ZEROS>::ACTIVE_TAP_COUNT == 0);
+
+        checkConstexprFir<MIXED, 1>("mixed");
+        checkConstexprFir<MIXED, 3>("mixed");
+        checkConstexprFir<MIXED, 1000>("mixed");
+        checkConstexprFir<MIXED_FLOAT, 1000>("mixed float");
+        checkConstexprFir<UNIT, 257>("unit");
+        checkConstexprFir<ZEROS, 100>("zeros");
+        checkConstexprFir<SINGLE, 100>("single");
+    }
+
+    /**
+     * convolve1DParallel over enough output samples for several tiles, on a pool of `threads`
+     * workers. Every sample is summed in convolve1D's order, so the result must match exactly.
+     */
+    template<std::floating_point T, int M>
+    void checkParallel(int threads)
+    {
+        constexpr int N = 3 * signals::PARALLEL_CONVOLUTION_TILE<T> + 100;
+        const std::vector<T> x = test::randomSignal<T>(N, M);
+        const std::vector<T> h = test::randomSignal<T>(M, M + 1);
+        const std::vector<T> expected = test::referenceConvolution<N, M>(std::span<const T>(x), std::span<const T>(h));
+
+        platform::ThreadPool pool(threads);
+        std::vector<T> y(N + M - 1);
+        signals::convolve1DParallel<T>(x, h, y, pool);
+        test::check(y == expected, "convolve1DParallel m " + std::to_string(M) + " on " + std::to_string(threads) + " threads");
+    }
+
+    void testParallel()
+    {
+        for (int threads : {1, 3, 8})
+        {
+            checkParallel<float, 37>(threads);
+            checkParallel<double, 37>(threads);
+            checkParallel<double, 1000>(threads);
+        }
+
+        // Empty inputs want an empty output, and anything else is rejected
+        const std::vector<double> x(10, 1.0);
+        std::vector<double> y;
+        signals::convolve1DParallel<double>(x, {}, y);
+        for (auto [input, output, name] : {std::tuple{std::span<const double>(x), 9, "a short output"},
+                                           {std::span<const double>(), 9, "an output for an empty input"}})
+        {
+            std::vector<double> out(output);
+            bool rejected = false;
+            try
+            {
+                signals::convolve1DParallel<double>(input, x, out);
+            }
+            catch (const std::invalid_argument&)
+            {
+                rejected = true;
+            }
+            test::check(rejected, std::string("convolve1DParallel rejects ") + name);
+        }
+    }
+
+    constexpr signals::ConvolutionStrategy ALL_STRATEGIES[] = {
+            signals::ConvolutionStrategy::Direct, signals::ConvolutionStrategy::SimdDirect, signals::ConvolutionStrategy::Fft,
+            signals::ConvolutionStrategy::Partitioned, signals::ConvolutionStrategy::Sparse};
+
+    /**
+     * Every strategy of convolve() on an N-sample signal and an M-tap kernel against convolve1D.
+     */
+    template<std::floating_point T, int N, int M>
+    void checkStrategies()
+    {
+        const std::vector<T> x = test::randomSignal<T>(N, N);
+        const std::vector<T> h = test::randomSignal<T>(M, M + 1);
+        const std::vector<T> expected = test::referenceConvolution<N, M>(std::span<const T>(x), std::span<const T>(h));
+        for (signals::ConvolutionStrategy strategy : ALL_STRATEGIES)
+        {
+            std::vector<T> y(N + M - 1);
+            signals::convolve(strategy, std::span<const T>(x), std::span<const T>(h), std::span<T>(y));
+            // The FFT strategies round differently from the direct sum
+            test::checkClose(y, expected, 100 * tolerance<T>(),
+                             std::string("convolve ") + signals::strategyName(strategy) + " n " + std::to_string(N) + " m " + std::to_string(M));
+        }
+    }
+
+    void testStrategies()
+    {
+        checkStrategies<float, 1, 1>();
+        checkStrategies<float, 1000, 37>();
+        checkStrategies<double, 1000, 37>();
+        checkStrategies<double, 37, 1000>();
+        checkStrategies<float, 300, 3000>();
+        checkStrategies<double, 5000, 700>();
+
+        // Empty inputs want an empty output, and anything else is rejected
+        const std::vector<double> x(10, 1.0);
+        for (signals::ConvolutionStrategy strategy : ALL_STRATEGIES)
+        {
+            const std::string name = std::string("convolve ") + signals::strategyName(strategy);
+            std::vector<double> y;
+            signals::convolve(strategy, std::span<const double>(), std::span<const double>(x), std::span<double>(y));
+            signals::convolve(strategy, std::span<const double>(x), std::span<const double>(), std::span<double>(y));
+            for (auto [input, output, what] : {std::tuple{std::span<const double>(x), 9, "a short output"},
+                                               {std::span<const double>(), 9, "an output for an empty input"}})
+            {
+                std::vector<double> out(output);
+                bool rejected = false;
+                try
+                {
+                    signals::convolve(strategy, input, std::span<const double>(x), std::span<double>(out));
+                }
+                catch (const std::invalid_argument&)
+                {
+                    rejected = true;
+                }
+                test::check(rejected, name + " rejects " + what);
+            }
+        }
+    }
+
+    /**
+     * The strategy-less convolve() takes the Sparse path for a kernel of a few echoes, and the
+     * planner's pick otherwise. Each path's rounding is its own, so the outputs match exactly.
+     */
+    template<std::floating_point T>
+    void testAutomaticStrategy()
+    {
+        constexpr int N = 2000;
+        constexpr int M = 3000;
+        const std::vector<T> x = test::randomSignal<T>(N, 4);
+        std::vector<T> echoes(M);
+        echoes[0] = T(1);
+        echoes[1200] = T(0.5);
+        echoes[M - 1] = T(-0.25);
+        const std::vector<T> dense = test::randomSignal<T>(M, 5);
+        const fft::Precision precision = std::is_same_v<T, float> ? fft::Precision::Single : fft::Precision::Double;
+
+        test::check(signals::detail::preferSparse(std::span<const T>(echoes)), "a three-tap echo kernel prefers Sparse");
+        test::check(!signals::detail::preferSparse(std::span<const T>(dense)), "a dense kernel doesn't prefer Sparse");
+        using Case = std::tuple<const std::vector<T>*, signals::ConvolutionStrategy, const char*>;
+        for (auto [h, strategy, name] : {Case{&echoes, signals::ConvolutionStrategy::Sparse, "echoes"},
+                                         Case{&dense, signals::ConvolutionPlanner::instance().choose(N, M, precision), "dense"}})
+        {
+            std::vector<T> automatic(N + M - 1);
+            std::vector<T> explicitly(N + M - 1);
+            signals::convolve(std::span<const T>(x), std::span<const T>(*h), std::span<T>(automatic));
+            signals::convolve(strategy, std::span<const T>(x), std::span<const T>(*h), std::span<T>(explicitly));
+            test::check(automatic == explicitly, std::string("convolve picks ") + signals::strategyName(strategy) + " for " + name);
+            test::checkClose(automatic, test::referenceConvolution<N, M>(std::span<const T>(x), std::span<const T>(*h)),
+                             100 * tolerance<T>(), std::string("convolve ") + name);
+        }
+    }
+
+    void writeFile(const std::string& path, const std::string& contents)
+    {
+        std::ofstream(path) << contents;
+    }
+
+    void testCalibrationFiles()
+    {
+        const std::string path = (std::filesystem::temp_directory_path() / "libdsp_test_calibration.txt").string();
+        constexpr const char* NAMES[] = {"direct", "simd", "fft", "partitioned"};
+        constexpr signals::ConvolutionStrategy STRATEGIES[] = {signals::ConvolutionStrategy::Direct, signals::ConvolutionStrategy::SimdDirect,
+                                                               signals::ConvolutionStrategy::Fft, signals::ConvolutionStrategy::Partitioned};
+
+        // A table unlike the defaults, so that a successful load shows in choose()
+        const auto cell = [](int precision, int log2N, int log2M) { return (precision + log2N / 2 + log2M) % 4; };
+        std::string table = "dsp-convolution-calibration 1\n";
+        for (int precision = 0; precision < 2; ++precision)
+        {
+            for (int log2N = 6; log2N <= 16; log2N += 2)
+            {
+                table += (precision == 0 ? "f32 " : "f64 ") + std::to_string(log2N);
+                for (int log2M = 0; log2M <= 16; ++log2M)
+                {
+                    table += std::string(" ") + NAMES[cell(precision, log2N, log2M)];
+                }
+                table += "\n";
+            }
+        }
+        const auto matchesTable = [&](const signals::ConvolutionPlanner& planner) {
+            bool matches = true;
+            for (int precision = 0; precision < 2; ++precision)
+            {
+                for (int log2N = 6; log2N <= 16; log2N += 2)
+                {
+                    for (int log2M = 0; log2M <= log2N; ++log2M)
+                    {
+                        matches = matches && planner.choose(1 << log2N, 1 << log2M, precision == 0 ? fft::Precision::Single : fft::Precision::Double) ==
+                                                     STRATEGIES[cell(precision, log2N, log2M)];
+                    }
+                }
+            }
+            return matches;
+        };
+
+        signals::ConvolutionPlanner written;
+        writeFile(path, table);
+        test::check(written.loadCalibration(path) && written.isCalibrated(), "loadCalibration reads a complete table");
+        test::check(matchesTable(written), "choose() follows the loaded table");
+
+        // save -> load reproduces every decision
+        test::check(written.saveCalibration(path), "saveCalibration writes the file");
+        signals::ConvolutionPlanner loaded;
+        test::check(loaded.loadCalibration(path) && loaded.isCalibrated(), "loadCalibration reads back saveCalibration's file");
+        test::check(matchesTable(loaded), "a saved and reloaded table makes the same choices");
+
+        // Damaged files are rejected whole and leave the current table alone
+        signals::ConvolutionPlanner rejected;
+        const signals::ConvolutionStrategy defaultChoice = rejected.choose(4096, 64, fft::Precision::Single);
+        const std::string lastLine = table.substr(table.rfind('\n', table.size() - 2) + 1);
+        for (auto [contents, what] : {std::pair{table.substr(0, table.size() - lastLine.size()), "a file missing its last line"},
+                                      {table.substr(0, table.size() - lastLine.size() / 2), "a file cut off mid-line"},
+                                      {"dsp-convolution-calibration 2" + table.substr(table.find('\n')), "another version"},
+                                      {"not-calibration 1" + table.substr(table.find('\n')), "a foreign header"},
+                                      {table + "f32 6 sparse" + lastLine.substr(lastLine.find(' ', 4)), "an unknown strategy"}})
+        {
+            writeFile(path, contents);
+            test::check(!rejected.loadCalibration(path), std::string("loadCalibration rejects ") + what);
+            test::check(!rejected.isCalibrated() && rejected.choose(4096, 64, fft::Precision::Single) == defaultChoice,
+                        std::string("rejecting ") + what + " keeps the default table");
+        }
+        test::check(!rejected.loadCalibration(path + ".missing"), "loadCalibration rejects a missing file");
+
+        loaded.reset();
+        test::check(!loaded.isCalibrated() && loaded.choose(4096, 64, fft::Precision::Single) == defaultChoice,
+                    "reset() goes back to the default table");
+        std::filesystem::remove(path);
+    }
+
+    /**
+     * convolveBatch with every strategy on channels of the given lengths against convolve1D of
+     * each channel. Channels long enough for several tiles read the inner tiles in place and
+     * zero-pad the edges; the short ones run out of outputs part-way through a channel group.
+     */
+    template<std::floating_point T, int M, int... Lengths>
+    void checkBatch(platform::ThreadPool& pool)
+    {
+        const std::vector<T> h = test::randomSignal<T>(M, M + 2);
+        const std::vector<std::vector<T>> inputs{test::randomSignal<T>(Lengths, Lengths + 3)...};
+        std::vector<std::vector<T>> expected;
+        size_t channel = 0;
+        (expected.push_back(test::referenceConvolution<Lengths, M>(std::span<const T>(inputs[channel++]), std::span<const T>(h))), ...);
+
+        std::vector<std::span<const T>> in(inputs.begin(), inputs.end());
+        for (signals::ConvolutionStrategy strategy : ALL_STRATEGIES)
+        {
+            std::vector<std::vector<T>> outputs{std::vector<T>(Lengths + M - 1)...};
+            std::vector<std::span<T>> out(outputs.begin(), outputs.end());
+            signals::convolveBatch<T>(strategy, in, h, out, pool);
+            for (size_t c = 0; c < outputs.size(); ++c)
+            {
+                test::checkClose(outputs[c], expected[c], 100 * tolerance<T>(),
+                                 std::string("convolveBatch ") + signals::strategyName(strategy) + " m " + std::to_string(M) +
+                                 " channel " + std::to_string(c) + " n " + std::to_string(inputs[c].size()));
+            }
+        }
+    }
+
+    template<std::floating_point T>
+    void testBatch()
+    {
+        platform::ThreadPool pool(3);
+        constexpr int TILE = signals::detail::BATCH_TILE;
+        checkBatch<T, 1, 1, 100, 3 * TILE>(pool);
+        checkBatch<T, 37, 1, 100, TILE - 1, TILE, 4 * TILE + 5, 2 * TILE>(pool);
+        checkBatch<T, signals::detail::BATCH_TAP_BLOCK + 500, 7, 5 * TILE, TILE + 3, 3000, 4 * TILE>(pool);
+        checkBatch<T, 3 * signals::detail::BATCH_TAP_BLOCK, 4 * TILE, 1000>(pool);
+
+        // One row per channel; a sparse kernel takes the Sparse path, which must agree with it exactly
+        constexpr int N = 3000;
+        constexpr int M = 2000;
+        Buffer2D<T> x(5, N);
+        std::vector<T> echoes(M);
+        echoes[0] = T(1);
+        echoes[M - 1] = T(0.5);
+        for (const std::vector<T>& h : {echoes, test::randomSignal<T>(M, 9)})
+        {
+            std::vector<std::vector<T>> expected;
+            for (int c = 0; c < x.rows(); ++c)
+            {
+                const std::vector<T> row = test::randomSignal<T>(N, 10 + c);
+                std::copy(row.begin(), row.end(), x.row(c).begin());
+                expected.push_back(test::referenceConvolution<N, M>(std::span<const T>(row), std::span<const T>(h)));
+            }
+            const Buffer2D<T> y = signals::convolveBatch<T>(x, h, pool);
+            test::check(y.rows() == x.rows() && y.columns() == N + M - 1, "convolveBatch Buffer2D output shape");
+            for (int c = 0; c < y.rows(); ++c)
+            {
+                test::checkClose(y.row(c), std::span<const T>(expected[c]), 100 * tolerance<T>(),
+                                 "convolveBatch Buffer2D row " + std::to_string(c));
+                if (&h == &echoes)
+                {
+                    std::vector<T> sparse(N + M - 1);
+                    signals::convolve(signals::ConvolutionStrategy::Sparse, x.row(c), std::span<const T>(h), std::span<T>(sparse));
+                    test::check(std::equal(sparse.begin(), sparse.end(), y.row(c).begin()), "convolveBatch picks Sparse for echoes");
+                }
+            }
+        }
+
+        // Outputs must pair up with inputs and hold N + M - 1 samples
+        const std::vector<T> h = test::randomSignal<T>(5, 11);
+        const std::vector<T> input(10);
+        std::vector<T> output(14);
+        std::vector<T> shortOutput(13);
+        const std::vector<std::span<const T>> in{input, input};
+        for (auto [out, what] : {std::pair{std::vector<std::span<T>>{output}, "one output for two inputs"},
+                                 {std::vector<std::span<T>>{output, shortOutput}, "a short output"}})
+        {
+            bool rejected = false;
+            try
+            {
+                signals::convolveBatch<T>(signals::ConvolutionStrategy::Direct, in, h, out, pool);
+            }
+            catch (const std::invalid_argument&)
+            {
+                rejected = true;
+            }
+            test::check(rejected, std::string("convolveBatch rejects ") + what);
+        }
+    }
+}
+
+int main()
+{
+    testConstexprFir();
+    testParallel();
+    testStrategies();
+    testAutomaticStrategy<float>();
+    testAutomaticStrategy<double>();
+    testCalibrationFiles();
+    testBatch<float>();
+    testBatch<double>();
+    return dsp::test::finish("test_convolution");
+}
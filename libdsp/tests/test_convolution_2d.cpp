@@ -0,0 +1,187 @@
+#include "test_helpers.h"
+
+#include "libdsp/signal_processing/convolution_2d.h"
+
+#include <string>
+#include <vector>
+
+// convolve2D and convolve2DSeparable against the 2D direct-form sum in double precision, on
+// images that span several row bands and column tiles.
+
+namespace
+{
+    using namespace dsp;
+
+    constexpr int IMAGE_ROWS = 2 * signals::detail::ROW_BAND + 7;
+    constexpr int IMAGE_COLUMNS = 2 * signals::detail::COLUMN_TILE + 77;
+
+    template<std::floating_point T>
+    double tolerance()
+    {
+        return std::is_same_v<T, float> ? 1e-5 : 1e-12;
+    }
+
+    const char* regionName(signals::ConvolutionRegion region)
+    {
+        switch (region)
+        {
+            case signals::ConvolutionRegion::Same: return "Same";
+            case signals::ConvolutionRegion::Valid: return "Valid";
+            default: return "Full";
+        }
+    }
+
+    template<std::floating_point T>
+    Buffer2D<T> randomImage(int rows, int columns, unsigned seed)
+    {
+        const std::vector<T> values = test::randomSignal<T>(rows * columns, seed);
+        Buffer2D<T> image(rows, columns);
+        for (int r = 0; r < rows; ++r)
+        {
+            for (int c = 0; c < columns; ++c)
+            {
+                image(r, c) = values[static_cast<size_t>(r) * columns + c];
+            }
+        }
+        return image;
+    }
+
+    /**
+     * y(i, j) = \sum_{a, b} h(a, b) x(i - a, j - b) over the full output, cut down to `region`
+     * the same way as 1D convolution in each dimension.
+     */
+    template<std::floating_point T>
+    Buffer2D<double> reference(const Buffer2D<T>& x, const Buffer2D<T>& h, signals::ConvolutionRegion region)
+    {
+        Buffer2D<double> full(x.rows() + h.rows() - 1, x.columns() + h.columns() - 1);
+        for (int r = 0; r < x.rows(); ++r)
+        {
+            for (int c = 0; c < x.columns(); ++c)
+            {
+                for (int a = 0; a < h.rows(); ++a)
+                {
+                    for (int b = 0; b < h.columns(); ++b)
+                    {
+                        full(r + a, c + b) += static_cast<double>(x(r, c)) * h(a, b);
+                    }
+                }
+            }
+        }
+
+        const auto [rowOffset, rows] = signals::regionBounds(region, x.rows(), h.rows());
+        const auto [columnOffset, columns] = signals::regionBounds(region, x.columns(), h.columns());
+        Buffer2D<double> y(rows, columns);
+        for (int r = 0; r < rows; ++r)
+        {
+            for (int c = 0; c < columns; ++c)
+            {
+                y(r, c) = full(rowOffset + r, columnOffset + c);
+            }
+        }
+        return y;
+    }
+
+    template<std::floating_point T>
+    void checkImage(const Buffer2D<T>& actual, const Buffer2D<double>& expected, const std::string& name)
+    {
+        if (actual.rows() != expected.rows() || actual.columns() != expected.columns())
+        {
+            test::check(false, name + ": got " + std::to_string(actual.rows()) + " x " + std::to_string(actual.columns()) +
+                               ", expected " + std::to_string(expected.rows()) + " x " + std::to_string(expected.columns()));
+            return;
+        }
+        for (int r = 0; r < actual.rows(); ++r)
+        {
+            test::checkClose(actual.row(r), expected.row(r), tolerance<T>(), name + " row " + std::to_string(r));
+        }
+    }
+
+    template<std::floating_point T>
+    void testConvolve2D()
+    {
+        const Buffer2D<T> x = randomImage<T>(IMAGE_ROWS, IMAGE_COLUMNS, 1);
+        for (auto [rows, columns] : {std::pair{1, 1}, {5, 7}, {9, 4}})
+        {
+            const std::string shape = std::to_string(rows) + "x" + std::to_string(columns);
+
+            // Rank 1: the outer product of two random vectors
+            const std::vector<T> column = test::randomSignal<T>(rows, rows);
+            const std::vector<T> row = test::randomSignal<T>(columns, columns + 10);
+            Buffer2D<T> separable(rows, columns);
+            for (int a = 0; a < rows; ++a)
+            {
+                for (int b = 0; b < columns; ++b)
+                {
+                    separable(a, b) = column[a] * row[b];
+                }
+            }
+            const Buffer2D<T> general = randomImage<T>(rows, columns, rows * columns);
+
+            for (signals::ConvolutionRegion region : {signals::ConvolutionRegion::Full, signals::ConvolutionRegion::Same,
+                                                      signals::ConvolutionRegion::Valid})
+            {
+                const std::string name = std::string(regionName(region)) + " " + shape;
+                const Buffer2D<double> expectedSeparable = reference(x, separable, region);
+                checkImage(signals::convolve2D(x, separable, region), expectedSeparable, "convolve2D separable " + name);
+                checkImage(signals::convolve2DSeparable(x, signals::SeparableKernel<T>{column, row}, region), expectedSeparable,
+                           "convolve2DSeparable " + name);
+                if (rows > 1 && columns > 1)
+                {
+                    checkImage(signals::convolve2D(x, general, region), reference(x, general, region), "convolve2D general " + name);
+                }
+            }
+        }
+
+        // A kernel larger than the image leaves no valid outputs
+        const Buffer2D<T> small = randomImage<T>(3, 4, 2);
+        const Buffer2D<T> large = randomImage<T>(5, 6, 3);
+        checkImage(signals::convolve2D(small, large, signals::ConvolutionRegion::Valid),
+                   reference(small, large, signals::ConvolutionRegion::Valid), "convolve2D kernel larger than the image");
+        checkImage(signals::convolve2D(small, large), reference(small, large, signals::ConvolutionRegion::Full),
+                   "convolve2D Full kernel larger than the image");
+    }
+
+    template<std::floating_point T>
+    void testSeparate()
+    {
+        const std::vector<T> column = test::randomSignal<T>(5, 1);
+        const std::vector<T> row = test::randomSignal<T>(3, 2);
+        Buffer2D<T> h(5, 3);
+        for (int a = 0; a < 5; ++a)
+        {
+            for (int b = 0; b < 3; ++b)
+            {
+                h(a, b) = column[a] * row[b];
+            }
+        }
+        const auto kernel = signals::separate(h);
+        bool factorsMatch = kernel.has_value();
+        for (int a = 0; factorsMatch && a < 5; ++a)
+        {
+            for (int b = 0; b < 3; ++b)
+            {
+                factorsMatch = factorsMatch && std::abs(kernel->column[a] * kernel->row[b] - h(a, b)) <= 1e-5 * std::abs(h(a, b)) + 1e-6;
+            }
+        }
+        test::check(factorsMatch, "separate factors a rank-1 kernel");
+
+        // Rank 2: the identity, and a rank-1 kernel with one entry changed
+        Buffer2D<T> identity(2, 2);
+        identity(0, 0) = T(1);
+        identity(1, 1) = T(1);
+        test::check(!signals::separate(identity).has_value(), "separate rejects the 2x2 identity");
+        Buffer2D<T> perturbed = h;
+        perturbed(2, 1) += T(0.01);
+        test::check(!signals::separate(perturbed).has_value(), "separate rejects a rank-2 kernel");
+        test::check(!signals::separate(Buffer2D<T>(3, 3)).has_value(), "separate rejects an all-zero kernel");
+    }
+}
+
+int main()
+{
+    testConvolve2D<float>();
+    testConvolve2D<double>();
+    testSeparate<float>();
+    testSeparate<double>();
+    return dsp::test::finish("test_convolution_2d");
+}
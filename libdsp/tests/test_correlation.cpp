@@ -0,0 +1,302 @@
+#include "test_helpers.h"
+
+#include "libdsp/signal_processing/correlation.h"
+#include "libdsp/signal_processing/matched_filter_bank.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// correlate, correlateLags and autocorrelate against convolve1D of x with y reversed, which puts
+// lag k at output k + M - 1, in every region and scaling; MatchedFilterBank against correlate.
+
+namespace
+{
+    using namespace dsp;
+
+    constexpr signals::CorrelationScaling ALL_SCALINGS[] = {signals::CorrelationScaling::None, signals::CorrelationScaling::Biased,
+                                                            signals::CorrelationScaling::Unbiased, signals::CorrelationScaling::Coefficient};
+
+    template<std::floating_point T>
+    double tolerance()
+    {
+        return std::is_same_v<T, float> ? 1e-4 : 1e-10;
+    }
+
+    const char* scalingName(signals::CorrelationScaling scaling)
+    {
+        switch (scaling)
+        {
+            case signals::CorrelationScaling::Biased: return "Biased";
+            case signals::CorrelationScaling::Unbiased: return "Unbiased";
+            case signals::CorrelationScaling::Coefficient: return "Coefficient";
+            default: return "None";
+        }
+    }
+
+    const char* regionName(signals::ConvolutionRegion region)
+    {
+        switch (region)
+        {
+            case signals::ConvolutionRegion::Same: return "Same";
+            case signals::ConvolutionRegion::Valid: return "Valid";
+            default: return "Full";
+        }
+    }
+
+    /**
+     * The reference correlation of x (N samples) against y (M samples) at any lag, scaled the way
+     * CorrelationScaling documents it.
+     */
+    struct Reference
+    {
+        std::vector<double> full; // Lag k at k + M - 1
+        int n;
+        int m;
+        double norm;
+
+        double at(int lag, signals::CorrelationScaling scaling) const
+        {
+            if (lag <= -m || lag >= n)
+            {
+                return 0.0;
+            }
+            const double raw = full[lag + m - 1];
+            switch (scaling)
+            {
+                case signals::CorrelationScaling::Biased: return raw / n;
+                case signals::CorrelationScaling::Unbiased: return raw / (std::min(m, n - lag) - std::max(0, -lag));
+                case signals::CorrelationScaling::Coefficient: return raw / norm;
+                default: return raw;
+            }
+        }
+
+        std::vector<double> lags(int minLag, int maxLag, signals::CorrelationScaling scaling) const
+        {
+            std::vector<double> r;
+            for (int lag = minLag; lag <= maxLag; ++lag)
+            {
+                r.push_back(at(lag, scaling));
+            }
+            return r;
+        }
+    };
+
+    template<int N, int M, std::floating_point T>
+    Reference reference(const std::vector<T>& x, const std::vector<T>& y)
+    {
+        const std::vector<T> reversed(y.rbegin(), y.rend());
+        const std::vector<T> full = test::referenceConvolution<N, M>(std::span<const T>(x), std::span<const T>(reversed));
+        double energyX = 0.0;
+        double energyY = 0.0;
+        for (T sample : x)
+        {
+            energyX += static_cast<double>(sample) * sample;
+        }
+        for (T sample : y)
+        {
+            energyY += static_cast<double>(sample) * sample;
+        }
+        return {{full.begin(), full.end()}, N, M, std::sqrt(energyX * energyY)};
+    }
+
+    /**
+     * correlate() in every region and correlateLags() over the full lag range, a few lags around
+     * zero, and ranges partly or wholly outside [-(M - 1), N - 1].
+     */
+    template<std::floating_point T, int N, int M>
+    void checkCorrelate()
+    {
+        const std::vector<T> x = test::randomSignal<T>(N, N);
+        const std::vector<T> y = test::randomSignal<T>(M, M + 1);
+        const Reference expected = reference<N, M>(x, y);
+        const std::string size = " n " + std::to_string(N) + " m " + std::to_string(M);
+
+        for (signals::CorrelationScaling scaling : ALL_SCALINGS)
+        {
+            for (signals::ConvolutionRegion region : {signals::ConvolutionRegion::Full, signals::ConvolutionRegion::Same,
+                                                      signals::ConvolutionRegion::Valid})
+            {
+                const auto [offset, length] = signals::regionBounds(region, N, M);
+                const int firstLag = offset - (M - 1);
+                const std::vector<T> r = signals::correlate<T>(x, y, region, scaling);
+                test::checkClose(r, length == 0 ? std::vector<double>{} : expected.lags(firstLag, firstLag + length - 1, scaling),
+                                 tolerance<T>(), std::string("correlate ") + regionName(region) + " " + scalingName(scaling) + size);
+            }
+
+            for (auto [minLag, maxLag] : {std::pair{-(M - 1), N - 1}, {-3, 3}, {-(M - 1) - 20, N + 20}, {N, N + 9},
+                                          {-(M + 50), -M}, {N - 5, N + 5}})
+            {
+                test::checkClose(signals::correlateLags<T>(x, y, minLag, maxLag, scaling), expected.lags(minLag, maxLag, scaling),
+                                 tolerance<T>(), std::string("correlateLags ") + scalingName(scaling) + size + " lags " +
+                                 std::to_string(minLag) + " ... " + std::to_string(maxLag));
+            }
+        }
+    }
+
+    /**
+     * Signals long enough that a wide lag range is correlated block by block, with one block
+     * transform much shorter than N + M - 1.
+     */
+    template<std::floating_point T>
+    void checkBlockCorrelation()
+    {
+        constexpr int N = 24000;
+        constexpr int M = 18000;
+        static_assert(N + M - 1 > 2 * signals::detail::MIN_BLOCK_TRANSFORM);
+        const std::vector<T> x = test::randomSignal<T>(N, 6);
+        const std::vector<T> y = test::randomSignal<T>(M, 7);
+        const Reference expected = reference<N, M>(x, y);
+
+        for (signals::CorrelationScaling scaling : ALL_SCALINGS)
+        {
+            for (auto [minLag, maxLag] : {std::pair{-1000, 1000}, {-(M - 1) - 100, -(M - 1) + 1900}, {N - 1500, N + 500}})
+            {
+                test::checkClose(signals::correlateLags<T>(x, y, minLag, maxLag, scaling), expected.lags(minLag, maxLag, scaling),
+                                 tolerance<T>(), std::string("correlateLags blocks ") + scalingName(scaling) + " lags " +
+                                 std::to_string(minLag) + " ... " + std::to_string(maxLag));
+            }
+        }
+    }
+
+    template<std::floating_point T, int N>
+    void checkAutocorrelate()
+    {
+        const std::vector<T> x = test::randomSignal<T>(N, N + 2);
+        const Reference expected = reference<N, N>(x, x);
+        for (signals::CorrelationScaling scaling : ALL_SCALINGS)
+        {
+            // The default and an overlong maxLag cover every lag; a short one takes correlateLags
+            for (auto [maxLag, lastLag] : {std::pair{-1, N - 1}, {N + 10, N - 1}, {N / 8, N / 8}, {0, 0}})
+            {
+                test::checkClose(signals::autocorrelate<T>(x, maxLag, scaling), expected.lags(0, lastLag, scaling), tolerance<T>(),
+                                 std::string("autocorrelate ") + scalingName(scaling) + " n " + std::to_string(N) + " max lag " +
+                                 std::to_string(maxLag));
+            }
+        }
+        const std::vector<T> coefficient = signals::autocorrelate<T>(x, 0, signals::CorrelationScaling::Coefficient);
+        test::check(std::abs(coefficient[0] - T(1)) < 1e-5, "autocorrelate Coefficient is 1 at lag 0");
+    }
+
+    template<std::floating_point T>
+    void testCorrelation()
+    {
+        checkCorrelate<T, 1, 1>();
+        checkCorrelate<T, 1000, 37>();
+        checkCorrelate<T, 37, 1000>();
+        checkCorrelate<T, 3000, 3000>();
+        checkBlockCorrelation<T>();
+        checkAutocorrelate<T, 1>();
+        checkAutocorrelate<T, 500>();
+        checkAutocorrelate<T, 5000>();
+
+        // An exact copy of part of x peaks below 1: the rest of x's energy stays in the norm
+        const std::vector<T> x = test::randomSignal<T>(1000, 8);
+        const std::vector<T> y(x.begin() + 100, x.begin() + 300);
+        const std::vector<T> r = signals::correlateLags<T>(x, y, 100, 100, signals::CorrelationScaling::Coefficient);
+        const Reference expected = reference<1000, 200>(x, y);
+        test::check(std::abs(r[0] - expected.at(100, signals::CorrelationScaling::Coefficient)) < 1e-5 && r[0] < T(0.9),
+                    "correlateLags Coefficient of a partial match");
+
+        bool rejected = false;
+        try
+        {
+            signals::correlateLags<T>(x, y, 1, 0);
+        }
+        catch (const std::invalid_argument&)
+        {
+            rejected = true;
+        }
+        test::check(rejected, "correlateLags rejects maxLag < minLag");
+    }
+
+    /**
+     * MatchedFilterBank::correlate() against correlate(), and detect() against the argmax of
+     * MatchedFilterBank::correlate() for every region, scaling and peak search.
+     */
+    template<std::floating_point T>
+    void testMatchedFilterBank()
+    {
+        constexpr int WINDOW = 1000;
+        constexpr int LONG_TEMPLATE = 1500;
+        const std::vector<std::vector<T>> templates{test::randomSignal<T>(50, 1), test::randomSignal<T>(200, 2),
+                                                    test::randomSignal<T>(LONG_TEMPLATE, 3)};
+        const std::vector<std::span<const T>> spans(templates.begin(), templates.end());
+        const signals::MatchedFilterBank<T> bank(spans, WINDOW);
+        platform::ThreadPool pool(3);
+
+        // Template 0 at lag 300 and template 1 inverted at lag 700, in noise
+        std::vector<T> window = test::randomSignal<T>(WINDOW, 4);
+        for (int i = 0; i < 50; ++i)
+        {
+            window[300 + i] += 4 * templates[0][i];
+        }
+        for (int i = 0; i < 200; ++i)
+        {
+            window[700 + i] -= 4 * templates[1][i];
+        }
+
+        // A window shorter than the bank's maximum is padded the same way
+        for (int length : {WINDOW, 600})
+        {
+            const std::span<const T> x(window.data(), length);
+            const std::string size = " window " + std::to_string(length);
+            for (signals::CorrelationScaling scaling : ALL_SCALINGS)
+            {
+                for (signals::ConvolutionRegion region : {signals::ConvolutionRegion::Full, signals::ConvolutionRegion::Same,
+                                                          signals::ConvolutionRegion::Valid})
+                {
+                    const std::string name = std::string(regionName(region)) + " " + scalingName(scaling) + size;
+                    std::vector<std::vector<T>> correlations;
+                    for (int index = 0; index < bank.templateCount(); ++index)
+                    {
+                        correlations.push_back(bank.correlate(x, index, region, scaling));
+                        test::checkClose(correlations.back(), signals::correlate<T>(x, spans[index], region, scaling), tolerance<T>(),
+                                         "MatchedFilterBank::correlate template " + std::to_string(index) + " " + name);
+                    }
+
+                    for (signals::PeakSearch search : {signals::PeakSearch::Largest, signals::PeakSearch::LargestMagnitude})
+                    {
+                        const auto peaks = bank.detect(x, region, scaling, search, pool);
+                        bool matches = static_cast<int>(peaks.size()) == bank.templateCount();
+                        for (int index = 0; matches && index < bank.templateCount(); ++index)
+                        {
+                            const std::vector<T>& r = correlations[index];
+                            signals::MatchedFilterPeak<T> expected;
+                            if (!r.empty())
+                            {
+                                const auto best = search == signals::PeakSearch::Largest
+                                        ? std::max_element(r.begin(), r.end())
+                                        : std::max_element(r.begin(), r.end(), [](T a, T b) { return std::abs(a) < std::abs(b); });
+                                const int m = bank.templateLength(index);
+                                const int firstLag = signals::regionBounds(region, length, m).first - (m - 1);
+                                expected = {firstLag + static_cast<int>(best - r.begin()), *best};
+                            }
+                            matches = peaks[index].lag == expected.lag && peaks[index].value == expected.value;
+                        }
+                        test::check(matches, std::string("MatchedFilterBank::detect ") +
+                                             (search == signals::PeakSearch::Largest ? "Largest " : "LargestMagnitude ") + name);
+                    }
+                }
+            }
+        }
+
+        // The planted copies are found; the long template has no Valid lags in the window
+        const auto peaks = bank.detect(window, signals::ConvolutionRegion::Full, signals::CorrelationScaling::None,
+                                       signals::PeakSearch::LargestMagnitude, pool);
+        test::check(peaks[0].lag == 300 && peaks[0].value > 0, "MatchedFilterBank::detect finds a planted template");
+        test::check(peaks[1].lag == 700 && peaks[1].value < 0, "MatchedFilterBank::detect finds an inverted template by magnitude");
+        const auto valid = bank.detect(window, signals::ConvolutionRegion::Valid);
+        test::check(valid[2].lag == 0 && valid[2].value == 0, "MatchedFilterBank::detect reports an empty region as lag 0, value 0");
+    }
+}
+
+int main()
+{
+    testCorrelation<float>();
+    testCorrelation<double>();
+    testMatchedFilterBank<float>();
+    testMatchedFilterBank<double>();
+    return dsp::test::finish("test_correlation");
+}
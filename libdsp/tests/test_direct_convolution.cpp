@@ -0,0 +1,138 @@
+#include "test_helpers.h"
+
+#include "libdsp/signal_processing/direct_convolution.h"
+
+#include <string>
+#include <vector>
+
+// The hand-vectorized direct-form kernels at every SIMD level the host runs, against the plain
+// direct-form sum in double precision.
+
+namespace
+{
+    using namespace dsp;
+
+    template<std::floating_point T>
+    std::vector<double> reference(const std::vector<T>& x, const std::vector<T>& h)
+    {
+        const int n = static_cast<int>(x.size());
+        const int m = static_cast<int>(h.size());
+        std::vector<double> y(n + m - 1, 0.0);
+        for (int i = 0; i < n; ++i)
+        {
+            for (int j = 0; j < m; ++j)
+            {
+                y[i + j] += static_cast<double>(x[i]) * h[j];
+            }
+        }
+        return y;
+    }
+
+    template<std::floating_point T>
+    double tolerance()
+    {
+        return std::is_same_v<T, float> ? 1e-5 : 1e-13;
+    }
+
+    template<std::floating_point T>
+    std::vector<T> withSymmetry(std::vector<T> h, signals::FirSymmetry symmetry)
+    {
+        const int m = static_cast<int>(h.size());
+        for (int j = 0; j < m / 2; ++j)
+        {
+            h[m - 1 - j] = symmetry == signals::FirSymmetry::Antisymmetric ? -h[j] : h[j];
+        }
+        if (symmetry == signals::FirSymmetry::Antisymmetric && m % 2 == 1)
+        {
+            h[m / 2] = T(0);
+        }
+        return h;
+    }
+
+    template<std::floating_point T>
+    void testKernels(const std::string& level)
+    {
+        for (int m : {1, 2, 3, 8, 17, 64, 255})
+        {
+            for (int n : {1, 5, 100, 1000})
+            {
+                const std::vector<T> x = test::randomSignal<T>(n, n);
+                const std::vector<T> h = test::randomSignal<T>(m, m + 1);
+                const std::vector<double> full = reference(x, h);
+                const std::string name = level + " n " + std::to_string(n) + " m " + std::to_string(m);
+
+                std::vector<T> y(n + m - 1);
+                signals::convolveDirect(x.data(), n, h.data(), m, y.data());
+                test::checkClose(y, full, tolerance<T>(), "convolveDirect " + name);
+
+                if (n >= m)
+                {
+                    std::vector<T> valid(n - m + 1);
+                    signals::convolveValid(x.data(), n, h.data(), m, valid.data());
+                    test::checkClose(valid, std::vector<double>(full.begin() + m - 1, full.begin() + n), tolerance<T>(), "convolveValid " + name);
+                }
+
+                for (signals::FirSymmetry symmetry : {signals::FirSymmetry::Symmetric, signals::FirSymmetry::Antisymmetric})
+                {
+                    const std::vector<T> folded = withSymmetry(h, symmetry);
+                    const std::vector<double> foldedFull = reference(x, folded);
+                    const std::string foldedName = name + (symmetry == signals::FirSymmetry::Symmetric ? " symmetric" : " antisymmetric");
+                    test::check(m == 1 || signals::firSymmetry(folded.data(), m) == symmetry, "firSymmetry " + foldedName);
+
+                    signals::convolveDirectFolded(x.data(), n, folded.data(), m, symmetry, y.data());
+                    test::checkClose(y, foldedFull, tolerance<T>(), "convolveDirectFolded " + foldedName);
+                    if (n >= m)
+                    {
+                        std::vector<T> valid(n - m + 1);
+                        signals::convolveValidFolded(x.data(), n, folded.data(), m, symmetry, valid.data());
+                        test::checkClose(valid, std::vector<double>(foldedFull.begin() + m - 1, foldedFull.begin() + n), tolerance<T>(),
+                                         "convolveValidFolded " + foldedName);
+                    }
+                }
+
+                const double dot = signals::dotProduct(x.data(), x.data(), n);
+                double expectedDot = 0.0;
+                for (T v : x)
+                {
+                    expectedDot += static_cast<double>(v) * v;
+                }
+                test::check(std::abs(dot - expectedDot) <= tolerance<T>() * std::max(1.0, expectedDot), "dotProduct " + name);
+            }
+        }
+    }
+
+    template<std::floating_point T>
+    void testSparse(const std::string& level)
+    {
+        constexpr int N = 3000;
+        const std::vector<T> x = test::randomSignal<T>(N, 7);
+        const std::vector<int> offsets = {0, 3, 17, 64, 65, 400, 1999};
+        const std::vector<T> gains = test::randomSignal<T>(static_cast<int>(offsets.size()), 8);
+        std::vector<T> dense(offsets.back() + 1, T(0));
+        for (size_t t = 0; t < offsets.size(); ++t)
+        {
+            dense[offsets[t]] = gains[t];
+        }
+        const std::vector<double> full = reference(x, dense);
+
+        // The whole output, then a window starting mid-signal
+        for (auto [first, count] : {std::pair{0, static_cast<int>(full.size())}, {1000, 2500}})
+        {
+            std::vector<T> y(count);
+            signals::convolveSparse(x.data(), N, offsets.data(), gains.data(), static_cast<int>(offsets.size()), y.data(), first, count);
+            test::checkClose(y, std::vector<double>(full.begin() + first, full.begin() + first + count), tolerance<T>(),
+                             "convolveSparse " + level + " from " + std::to_string(first));
+        }
+    }
+}
+
+int main()
+{
+    dsp::test::forEachSimdLevel([](const std::string& level) {
+        testKernels<float>(level);
+        testKernels<double>(level);
+        testSparse<float>(level);
+        testSparse<double>(level);
+    });
+    return dsp::test::finish("test_direct_convolution");
+}
@@ -0,0 +1,130 @@
+#include "test_helpers.h"
+
+#include "libdsp/signal_processing/fast_convolution.h"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// FftConvolver (overlap-add and overlap-save) and fftConvolve1D against the direct-form sum in
+// double precision.
+
+namespace
+{
+    using namespace dsp;
+
+    template<std::floating_point T>
+    std::vector<double> reference(const std::vector<T>& x, const std::vector<T>& h)
+    {
+        const int n = static_cast<int>(x.size());
+        const int m = static_cast<int>(h.size());
+        std::vector<double> y(n + m - 1, 0.0);
+        for (int i = 0; i < n; ++i)
+        {
+            for (int j = 0; j < m; ++j)
+            {
+                y[i + j] += static_cast<double>(x[i]) * h[j];
+            }
+        }
+        return y;
+    }
+
+    template<std::floating_point T>
+    double tolerance()
+    {
+        return std::is_same_v<T, float> ? 1e-5 : 1e-12;
+    }
+
+    const char* modeName(signals::BlockMode mode)
+    {
+        return mode == signals::BlockMode::OverlapAdd ? "overlap-add" : "overlap-save";
+    }
+
+    template<std::floating_point T>
+    void testConvolver()
+    {
+        // fftSize 0 is the default; the others are the smallest and a non-power-of-two valid size
+        for (auto [m, fftSize] : {std::pair{1, 0}, {1, 2}, {17, 0}, {17, 48}, {100, 0}, {100, 120}, {700, 1536}})
+        {
+            const std::vector<T> h = test::randomSignal<T>(m, m);
+            for (int n : {1, 5, 1000, 3000})
+            {
+                const std::vector<T> x = test::randomSignal<T>(n, n + 1);
+                const std::vector<double> expected = reference(x, h);
+                for (signals::BlockMode mode : {signals::BlockMode::OverlapAdd, signals::BlockMode::OverlapSave})
+                {
+                    const signals::FftConvolver<T> convolver(std::span<const T>(h), mode, fftSize);
+                    std::vector<T> y(n + m - 1);
+                    convolver.convolve(x, y);
+                    test::checkClose(y, expected, tolerance<T>(),
+                                     std::string("FftConvolver ") + modeName(mode) + " n " + std::to_string(n) + " m " + std::to_string(m) +
+                                     " fft " + std::to_string(convolver.fftSize()));
+                }
+            }
+        }
+    }
+
+    template<std::floating_point T>
+    void testFftConvolve1D()
+    {
+        constexpr int N = 2000;
+        constexpr int M = 300;
+        const std::vector<T> x = test::randomSignal<T>(N, 1);
+        const std::vector<T> h = test::randomSignal<T>(M, 2);
+        const std::vector<double> expected = reference(x, h);
+
+        auto bx = std::make_unique<StaticBuffer<T, N>>();
+        auto bh = std::make_unique<StaticBuffer<T, M>>();
+        std::copy(x.begin(), x.end(), bx->_data.begin());
+        std::copy(h.begin(), h.end(), bh->_data.begin());
+        for (signals::BlockMode mode : {signals::BlockMode::OverlapAdd, signals::BlockMode::OverlapSave})
+        {
+            const auto y = std::make_unique<StaticBuffer<T, N + M - 1>>(signals::fftConvolve1D(*bx, *bh, mode));
+            test::checkClose(std::span<const T>(y->_data), std::span<const double>(expected), tolerance<T>(),
+                             std::string("fftConvolve1D ") + modeName(mode));
+        }
+    }
+
+    /**
+     * Runs `construct` and checks that it throws FftConvolver's own invalid_argument.
+     */
+    template<typename Construct>
+    void checkRejected(Construct&& construct, const std::string& what)
+    {
+        bool rejected = false;
+        try
+        {
+            construct();
+        }
+        catch (const std::invalid_argument& e)
+        {
+            rejected = std::string(e.what()).starts_with("dsp::signals::FftConvolver:");
+        }
+        test::check(rejected, "FftConvolver rejects " + what);
+    }
+
+    void testRejectedSizes()
+    {
+        const std::vector<float> h = test::randomSignal<float>(100, 3);
+        const std::span<const float> taps(h);
+        checkRejected([&] { signals::FftConvolver<float>(std::span<const float>(), signals::BlockMode::OverlapSave); }, "an empty impulse response");
+        checkRejected([&] { signals::FftConvolver<float>(taps, signals::BlockMode::OverlapSave, 100); }, "an FFT no longer than the impulse response");
+        checkRejected([&] { signals::FftConvolver<float>(taps, signals::BlockMode::OverlapSave, 1001); }, "an odd FFT size");
+        checkRejected([&] { signals::FftConvolver<float>(taps, signals::BlockMode::OverlapAdd, 2 * 7 * 16); }, "a factor of 7 in half the FFT size");
+
+        const signals::FftConvolver<float> convolver(taps);
+        const std::vector<float> x(10);
+        std::vector<float> y(10);
+        checkRejected([&] { convolver.convolve(x, y); }, "an output that isn't N + M - 1 samples");
+    }
+}
+
+int main()
+{
+    testConvolver<float>();
+    testConvolver<double>();
+    testFftConvolve1D<float>();
+    testFftConvolve1D<double>();
+    testRejectedSizes();
+    return dsp::test::finish("test_fast_convolution");
+}
@@ -0,0 +1,257 @@
+#include "test_helpers.h"
+
+#include "libdsp/fft/batch_fft.h"
+#include "libdsp/fft/fft.h"
+#include "libdsp/fft/large_fft.h"
+#include "libdsp/fft/plan_cache.h"
+#include "libdsp/fft/real_fft.h"
+
+#include <complex>
+#include <filesystem>
+#include <fstream>
+#include <numbers>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace dsp;
+    using Complex = std::complex<double>;
+
+    /**
+     * X[k] = scale * \sum_n x[n] e^{-+2 pi i k n / N}, with k n reduced modulo N into a table of twiddles.
+     */
+    std::vector<Complex> naiveDft(const std::vector<Complex>& x, fft::Direction direction)
+    {
+        const int n = static_cast<int>(x.size());
+        const double sign = direction == fft::Direction::Forward ? -1.0 : 1.0;
+        const double scale = direction == fft::Direction::Forward ? 1.0 : 1.0 / n;
+        std::vector<Complex> twiddles(n);
+        for (int m = 0; m < n; ++m)
+        {
+            twiddles[m] = std::polar(1.0, sign * 2.0 * std::numbers::pi * m / n);
+        }
+        std::vector<Complex> y(n);
+        for (int k = 0; k < n; ++k)
+        {
+            Complex sum = 0.0;
+            for (int i = 0; i < n; ++i)
+            {
+                sum += x[i] * twiddles[static_cast<long long>(k) * i % n];
+            }
+            y[k] = sum * scale;
+        }
+        return y;
+    }
+
+    template<std::floating_point T>
+    std::vector<std::complex<T>> randomComplex(int n, unsigned seed)
+    {
+        const std::vector<T> re = test::randomSignal<T>(n, seed);
+        const std::vector<T> im = test::randomSignal<T>(n, seed + 1);
+        std::vector<std::complex<T>> x(n);
+        for (int i = 0; i < n; ++i)
+        {
+            x[i] = {re[i], im[i]};
+        }
+        return x;
+    }
+
+    template<std::floating_point T>
+    std::vector<Complex> widened(const std::vector<std::complex<T>>& x)
+    {
+        return {x.begin(), x.end()};
+    }
+
+    template<std::floating_point T>
+    double tolerance()
+    {
+        return std::is_same_v<T, float> ? 1e-5 : 1e-12;
+    }
+
+    const char* directionName(fft::Direction direction)
+    {
+        return direction == fft::Direction::Forward ? "forward" : "inverse";
+    }
+
+    template<std::floating_point T>
+    void testPlan()
+    {
+        for (int n : {1, 2, 3, 4, 5, 6, 8, 9, 12, 15, 16, 25, 27, 30, 60, 64, 100, 120, 128, 243, 360, 1000, 1024})
+        {
+            for (fft::Direction direction : {fft::Direction::Forward, fft::Direction::Inverse})
+            {
+                std::vector<std::complex<T>> x = randomComplex<T>(n, n);
+                const std::vector<Complex> expected = naiveDft(widened(x), direction);
+                fft::Plan<T>(n, direction).execute(x);
+                test::checkClose(widened(x), expected, tolerance<T>(),
+                                 "Plan " + std::to_string(n) + " " + directionName(direction));
+            }
+        }
+    }
+
+    template<std::floating_point T>
+    void testRealPlan()
+    {
+        for (int n : {2, 4, 6, 8, 10, 12, 16, 30, 64, 120, 250, 1000, 1024})
+        {
+            const std::vector<T> x = test::randomSignal<T>(n, n);
+            std::vector<Complex> complexX(x.begin(), x.end());
+            std::vector<Complex> expected = naiveDft(complexX, fft::Direction::Forward);
+            expected.resize(n / 2 + 1);
+
+            const fft::RealPlan<T> forward(n, fft::Direction::Forward);
+            std::vector<std::complex<T>> spectrum(forward.spectrumSize());
+            forward.execute(std::span<const T>(x), spectrum);
+            test::checkClose(widened(spectrum), expected, tolerance<T>(), "RealPlan " + std::to_string(n) + " forward");
+
+            // The inverse takes the half spectrum back to the real signal
+            std::vector<T> roundTrip(n);
+            fft::RealPlan<T>(n, fft::Direction::Inverse).execute(std::span<const std::complex<T>>(spectrum), roundTrip);
+            test::checkClose(roundTrip, x, tolerance<T>(), "RealPlan " + std::to_string(n) + " inverse");
+        }
+    }
+
+    void writeFile(const std::string& path, const std::string& contents)
+    {
+        std::ofstream(path) << contents;
+    }
+
+    void testWisdom()
+    {
+        const std::string path = (std::filesystem::temp_directory_path() / "libdsp_test_wisdom.txt").string();
+
+        fft::PlanCache saved;
+        const auto complexPlan = saved.complexPlan<float>(60, fft::Direction::Forward);
+        const auto realPlan = saved.realPlan<double>(240, fft::Direction::Inverse);
+        saved.complexPlan<double>(1024, fft::Direction::Inverse);
+        test::check(saved.saveWisdom(path), "saveWisdom writes the file");
+
+        fft::PlanCache loaded;
+        test::check(loaded.loadWisdom(path), "loadWisdom reads back saveWisdom's file");
+        test::check(loaded.size() == saved.size(), "loadWisdom builds every saved plan");
+        test::check(loaded.complexPlan<float>(60, fft::Direction::Forward)->radices() == complexPlan->radices(), "wisdom keeps a complex plan's stages");
+        test::check(loaded.realPlan<double>(240, fft::Direction::Inverse)->radices() == realPlan->radices(), "wisdom keeps a real plan's stages");
+        test::check(loaded.size() == saved.size(), "lookups hit the plans loaded from wisdom");
+
+        // A stage layout other than factorize()'s is rebuilt as stored, and still transforms correctly
+        writeFile(path, "dsp-fft-wisdom 1\nf64 complex forward 60 5 3 2 2\n");
+        fft::PlanCache custom;
+        test::check(custom.loadWisdom(path), "loadWisdom accepts a valid non-default stage layout");
+        const auto plan = custom.complexPlan<double>(60, fft::Direction::Forward);
+        test::check(plan->radices() == std::vector<int>{5, 3, 2, 2}, "wisdom plans use the stored radices");
+        std::vector<std::complex<double>> x = randomComplex<double>(60, 9);
+        const std::vector<Complex> expected = naiveDft(x, fft::Direction::Forward);
+        plan->execute(x);
+        test::checkClose(x, expected, tolerance<double>(), "wisdom plan with stored radices");
+
+        // Malformed files are rejected; their valid lines still build plans
+        fft::PlanCache rejected;
+        test::check(!rejected.loadWisdom(path + ".missing"), "loadWisdom rejects a missing file");
+        writeFile(path, "not-wisdom 1\nf32 complex forward 64 4 4 4\n");
+        test::check(!rejected.loadWisdom(path) && rejected.size() == 0, "loadWisdom rejects a foreign header");
+        writeFile(path, "dsp-fft-wisdom 2\nf32 complex forward 64 4 4 4\n");
+        test::check(!rejected.loadWisdom(path) && rejected.size() == 0, "loadWisdom rejects another version");
+        writeFile(path, "dsp-fft-wisdom 1\nf32 complex\nf32 real inverse 64 4 2 4\nf32 complex forward 64 4 4\nf16 complex forward 64 4 4 4\n");
+        test::check(!rejected.loadWisdom(path), "loadWisdom reports truncated, impossible and unknown lines");
+        test::check(rejected.size() == 1, "loadWisdom still builds the valid lines of a damaged file");
+
+        std::filesystem::remove(path);
+    }
+
+    template<std::floating_point T>
+    void testLargePlan()
+    {
+        // Square (in-place transposes) and rectangular splits
+        for (int n : {36, 1000, 4096, 6000})
+        {
+            for (fft::Direction direction : {fft::Direction::Forward, fft::Direction::Inverse})
+            {
+                std::vector<std::complex<T>> x = randomComplex<T>(n, n);
+                const std::vector<Complex> expected = naiveDft(widened(x), direction);
+                fft::LargePlan<T>(n, direction).execute(x);
+                test::checkClose(widened(x), expected, 4 * tolerance<T>(),
+                                 "LargePlan " + std::to_string(n) + " " + directionName(direction));
+            }
+        }
+    }
+
+    template<std::floating_point T>
+    void testBatchPlan()
+    {
+        // Counts that are not a multiple of the lane count leave a partial group
+        for (int n : {8, 60, 64, 120})
+        {
+            const int count = 2 * fft::BatchPlan<T>::LANES + 3;
+            const fft::BatchPlan<T> plan(n, fft::Direction::Forward);
+            const std::vector<std::complex<T>> signals = randomComplex<T>(n * count, n);
+
+            // Frame-major: transform b is samples [b * n, (b + 1) * n)
+            std::vector<std::complex<T>> frames = signals;
+            plan.execute(frames, {count, 1, n});
+            // Interleaved: sample i of transform b is at i * count + b
+            std::vector<std::complex<T>> interleaved(signals.size());
+            for (int b = 0; b < count; ++b)
+            {
+                for (int i = 0; i < n; ++i)
+                {
+                    interleaved[static_cast<size_t>(i) * count + b] = signals[static_cast<size_t>(b) * n + i];
+                }
+            }
+            plan.execute(interleaved, {count, count, 1});
+
+            for (int b = 0; b < count; ++b)
+            {
+                const std::vector<std::complex<T>> frame(signals.begin() + b * n, signals.begin() + (b + 1) * n);
+                const std::vector<Complex> expected = naiveDft(widened(frame), fft::Direction::Forward);
+                std::vector<Complex> frameResult(n);
+                std::vector<Complex> interleavedResult(n);
+                for (int i = 0; i < n; ++i)
+                {
+                    frameResult[i] = frames[static_cast<size_t>(b) * n + i];
+                    interleavedResult[i] = interleaved[static_cast<size_t>(i) * count + b];
+                }
+                const std::string name = "BatchPlan " + std::to_string(n) + " transform " + std::to_string(b);
+                test::checkClose(frameResult, expected, tolerance<T>(), name + " frame-major");
+                test::checkClose(interleavedResult, expected, tolerance<T>(), name + " interleaved");
+            }
+        }
+
+        // Layouts that reach past the data, by one transform or by one sample, are rejected
+        const fft::BatchPlan<T> plan(64, fft::Direction::Forward);
+        std::vector<std::complex<T>> data(64 * 5);
+        for (auto [layout, name] : {std::pair{fft::BatchLayout{6, 1, 64}, "one transform too many"},
+                                    {fft::BatchLayout{5, 1, 65}, "a distance one too large"},
+                                    {fft::BatchLayout{5, 6, 1}, "a stride one too large"},
+                                    {fft::BatchLayout{-1, 1, 64}, "a negative count"}})
+        {
+            bool rejected = false;
+            try
+            {
+                plan.execute(data, layout);
+            }
+            catch (const std::invalid_argument&)
+            {
+                rejected = true;
+            }
+            test::check(rejected, std::string("BatchPlan rejects ") + name);
+        }
+        plan.execute(data, {5, 5, 1});
+        plan.execute(data, {0, 1, 64});
+    }
+}
+
+int main()
+{
+    testPlan<float>();
+    testPlan<double>();
+    testRealPlan<float>();
+    testRealPlan<double>();
+    testWisdom();
+    testLargePlan<float>();
+    testLargePlan<double>();
+    testBatchPlan<float>();
+    testBatchPlan<double>();
+    return dsp::test::finish("test_fft");
+}
@@ -0,0 +1,114 @@
+#include "test_helpers.h"
+
+#include "libdsp/signal_processing/fixed_point_convolution.h"
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+// Q15 / Q31 convolution at every SIMD level, against the exact sum of products in __int128,
+// rounded half up and saturated once. Every path promises that result bit for bit.
+
+namespace
+{
+    using namespace dsp;
+
+    template<typename Q>
+    constexpr int FRACTION_BITS = std::numeric_limits<Q>::digits;
+
+    template<typename Q>
+    std::vector<Q> reference(const std::vector<Q>& x, const std::vector<Q>& h)
+    {
+        const int n = static_cast<int>(x.size());
+        const int m = static_cast<int>(h.size());
+        std::vector<Q> y(n + m - 1);
+        for (int i = 0; i < n + m - 1; ++i)
+        {
+            __int128 sum = 0;
+            for (int j = std::max(0, i - n + 1); j < std::min(m, i + 1); ++j)
+            {
+                sum += static_cast<__int128>(h[j]) * x[i - j];
+            }
+            const __int128 rounded = (sum + (static_cast<__int128>(1) << (FRACTION_BITS<Q> - 1))) >> FRACTION_BITS<Q>;
+            y[i] = static_cast<Q>(std::clamp<__int128>(rounded, std::numeric_limits<Q>::min(), std::numeric_limits<Q>::max()));
+        }
+        return y;
+    }
+
+    /**
+     * Random Q values in [-limit, limit].
+     */
+    template<typename Q>
+    std::vector<Q> randomQ(int n, double limit, unsigned seed)
+    {
+        std::mt19937 gen{seed};
+        std::uniform_real_distribution<double> d{-limit, limit};
+        std::vector<Q> x(n);
+        for (Q& v : x)
+        {
+            v = static_cast<Q>(std::clamp(std::llround(d(gen) * (1LL << FRACTION_BITS<Q>)),
+                                          static_cast<long long>(std::numeric_limits<Q>::min()),
+                                          static_cast<long long>(std::numeric_limits<Q>::max())));
+        }
+        return x;
+    }
+
+    void convolveDirect(const std::int16_t* x, int n, const std::int16_t* h, int m, std::int16_t* y) { signals::convolveDirectQ15(x, n, h, m, y); }
+    void convolveDirect(const std::int32_t* x, int n, const std::int32_t* h, int m, std::int32_t* y) { signals::convolveDirectQ31(x, n, h, m, y); }
+    void convolveValid(const std::int16_t* x, int n, const std::int16_t* h, int m, std::int16_t* y) { signals::convolveValidQ15(x, n, h, m, y); }
+    void convolveValid(const std::int32_t* x, int n, const std::int32_t* h, int m, std::int32_t* y) { signals::convolveValidQ31(x, n, h, m, y); }
+
+    template<typename Q>
+    void checkCase(const std::vector<Q>& x, const std::vector<Q>& h, const std::string& name)
+    {
+        const int n = static_cast<int>(x.size());
+        const int m = static_cast<int>(h.size());
+        const std::vector<Q> expected = reference(x, h);
+
+        std::vector<Q> y(n + m - 1);
+        convolveDirect(x.data(), n, h.data(), m, y.data());
+        test::check(y == expected, "direct " + name);
+
+        if (n >= m)
+        {
+            std::vector<Q> valid(n - m + 1);
+            convolveValid(x.data(), n, h.data(), m, valid.data());
+            test::check(valid == std::vector<Q>(expected.begin() + m - 1, expected.begin() + n), "valid " + name);
+        }
+    }
+
+    template<typename Q>
+    void testFormat(const std::string& level)
+    {
+        const std::string format = std::string(sizeof(Q) == 2 ? "Q15 " : "Q31 ") + level;
+        for (int m : {1, 2, 5, 16, 33, 128})
+        {
+            for (int n : {1, 7, 100, 1000})
+            {
+                const std::string name = format + " n " + std::to_string(n) + " m " + std::to_string(m);
+                const std::vector<Q> x = randomQ<Q>(n, 1.0, n);
+
+                // \sum |h| < 2 runs on the narrow accumulators and vector kernels
+                checkCase(x, randomQ<Q>(m, 1.9 / m, m), name + " small taps");
+                // Larger taps take the wide-accumulator fallback and saturate
+                checkCase(x, randomQ<Q>(m, 1.0, m + 1), name + " full-scale taps");
+
+                // Full-scale input against taps that all push the same way saturates every output
+                const std::vector<Q> extreme(n, std::numeric_limits<Q>::min());
+                checkCase(extreme, std::vector<Q>(m, std::numeric_limits<Q>::min()), name + " saturating");
+                checkCase(extreme, randomQ<Q>(m, 1.9 / m, m + 2), name + " full-scale input");
+            }
+        }
+    }
+}
+
+int main()
+{
+    dsp::test::forEachSimdLevel([](const std::string& level) {
+        testFormat<std::int16_t>(level);
+        testFormat<std::int32_t>(level);
+    });
+    return dsp::test::finish("test_fixed_point");
+}
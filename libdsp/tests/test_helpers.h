@@ -0,0 +1,162 @@
+#ifndef SIGNAL_PROCESSING_BOOK_TEST_HELPERS_H
+#define SIGNAL_PROCESSING_BOOK_TEST_HELPERS_H
+
+// Shared by the libdsp test executables. There is no test framework: each executable counts its
+// failed checks, prints them, and exits non-zero if there were any, which is all ctest needs.
+
+#include "libdsp/platform/cpu_features.h"
+#include "libdsp/signal_processing/direct_convolution.h"
+#include "libdsp/signal_processing/signal_processing.h"
+#include "libdsp/storage/buffer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <concepts>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <span>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace dsp::test
+{
+    inline int& failureCount()
+    {
+        static int failures = 0;
+        return failures;
+    }
+
+    inline void check(bool condition, const std::string& what)
+    {
+        if (!condition)
+        {
+            ++failureCount();
+            std::cerr << "FAILED: " << what << '\n';
+        }
+    }
+
+    /**
+     * Checks that `actual` and `expected` have the same size and differ by at most
+     * tolerance * max(1, max |expected|) anywhere.
+     */
+    template<typename A, typename E>
+    void checkClose(std::span<const A> actual, std::span<const E> expected, double tolerance, const std::string& what)
+    {
+        if (actual.size() != expected.size())
+        {
+            check(false, what + ": got " + std::to_string(actual.size()) + " samples, expected " + std::to_string(expected.size()));
+            return;
+        }
+        double scale = 1.0;
+        double error = 0.0;
+        for (size_t i = 0; i < actual.size(); ++i)
+        {
+            scale = std::max(scale, static_cast<double>(std::abs(expected[i])));
+            error = std::max(error, static_cast<double>(std::abs(actual[i] - expected[i])));
+        }
+        std::ostringstream message;
+        message << what << ": max error " << error << " (scale " << scale << ")";
+        check(error <= tolerance * scale, message.str());
+    }
+
+    template<typename A, typename E>
+    void checkClose(const std::vector<A>& actual, const std::vector<E>& expected, double tolerance, const std::string& what)
+    {
+        checkClose(std::span<const A>(actual), std::span<const E>(expected), tolerance, what);
+    }
+
+    /**
+     * Reports the result and returns the process exit code.
+     */
+    inline int finish(const char* name)
+    {
+        if (failureCount() == 0)
+        {
+            std::cout << name << ": all checks passed\n";
+            return 0;
+        }
+        std::cout << name << ": " << failureCount() << " checks failed\n";
+        return 1;
+    }
+
+    template<std::floating_point T>
+    std::vector<T> randomSignal(int n, unsigned seed)
+    {
+        std::mt19937 gen{seed};
+        std::uniform_real_distribution<double> d{-1.0, 1.0};
+        std::vector<T> x(n);
+        for (T& sample : x)
+        {
+            sample = static_cast<T>(d(gen));
+        }
+        return x;
+    }
+
+    /**
+     * Feeds [0, total) to `process(offset, count)` in chunks of uneven sizes: single samples, odd
+     * sizes, and chunks larger than the streaming classes' internal blocks.
+     */
+    template<typename Process>
+    void forEachChunk(int total, Process&& process)
+    {
+        constexpr int CHUNKS[] = {1, 7, 64, 3, 250, 1500, 2, 1023};
+        int offset = 0;
+        for (int c = 0; offset < total; ++c)
+        {
+            const int count = std::min(CHUNKS[c % std::size(CHUNKS)], total - offset);
+            process(offset, count);
+            offset += count;
+        }
+    }
+
+    /**
+     * The full convolution of `x` (N samples) and `h` (M samples) by convolve1D, the reference the
+     * streaming classes are checked against.
+     */
+    template<int N, int M, std::floating_point T>
+    std::vector<T> referenceConvolution(std::span<const T> x, std::span<const T> h)
+    {
+        auto bx = std::make_unique<StaticBuffer<T, N>>();
+        auto bh = std::make_unique<StaticBuffer<T, M>>();
+        std::copy_n(x.begin(), N, bx->_data.begin());
+        std::copy_n(h.begin(), M, bh->_data.begin());
+        const auto y = std::make_unique<StaticBuffer<T, N + M - 1>>(signals::convolve1D(*bx, *bh));
+        return {y->_data.begin(), y->_data.end()};
+    }
+
+    inline const char* simdLevelName(platform::SimdLevel level)
+    {
+        switch (level)
+        {
+            case platform::SimdLevel::SSE2: return "SSE2";
+            case platform::SimdLevel::AVX2: return "AVX2";
+            case platform::SimdLevel::AVX512: return "AVX512";
+            case platform::SimdLevel::NEON: return "NEON";
+            default: return "Scalar";
+        }
+    }
+
+    /**
+     * Runs `body(levelName)` once per SIMD level this host and build can dispatch to, then goes
+     * back to the level that was active before.
+     */
+    template<typename Body>
+    void forEachSimdLevel(Body&& body)
+    {
+        const platform::SimdLevel active = signals::activeSimdLevel();
+        for (platform::SimdLevel level : {platform::SimdLevel::Scalar, platform::SimdLevel::SSE2, platform::SimdLevel::AVX2,
+                                          platform::SimdLevel::AVX512, platform::SimdLevel::NEON})
+        {
+            if (signals::setSimdLevel(level))
+            {
+                body(std::string(simdLevelName(level)));
+            }
+        }
+        signals::setSimdLevel(active);
+    }
+}
+
+#endif //SIGNAL_PROCESSING_BOOK_TEST_HELPERS_H
@@ -0,0 +1,361 @@
+#include "test_helpers.h"
+
+#include "libdsp/signal_processing/cic_filter.h"
+#include "libdsp/signal_processing/fir_filter.h"
+#include "libdsp/signal_processing/moving_average.h"
+#include "libdsp/signal_processing/multirate.h"
+#include "libdsp/signal_processing/partitioned_convolution.h"
+#include "libdsp/signal_processing/resampler.h"
+#include "libdsp/signal_processing/windows.h"
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Every streaming class is fed the same input in uneven chunks (test::forEachChunk) and checked
+// against one-shot convolve1D of the whole input with the class's equivalent impulse response.
+
+namespace
+{
+    using namespace dsp;
+
+    constexpr int INPUT_LENGTH = 3000;
+    constexpr double TOLERANCE = 1e-12;
+
+    const std::vector<double>& input()
+    {
+        static const std::vector<double> x = test::randomSignal<double>(INPUT_LENGTH, 1);
+        return x;
+    }
+
+    /**
+     * The first `count` samples of `y`, each delayed by `delay` samples (zeros in front).
+     */
+    std::vector<double> delayed(const std::vector<double>& y, int delay, int count)
+    {
+        std::vector<double> result(count, 0.0);
+        for (int i = delay; i < count; ++i)
+        {
+            result[i] = y[i - delay];
+        }
+        return result;
+    }
+
+    /**
+     * Every `factor`-th sample of `y`, starting at sample 0, up to `count` samples.
+     */
+    std::vector<double> downsampled(const std::vector<double>& y, int factor, int count)
+    {
+        std::vector<double> result(count);
+        for (int k = 0; k < count; ++k)
+        {
+            result[k] = y[static_cast<size_t>(k) * factor];
+        }
+        return result;
+    }
+
+    /**
+     * `x` with factor - 1 zeros after every sample.
+     */
+    std::vector<double> zeroStuffed(const std::vector<double>& x, int factor)
+    {
+        std::vector<double> u(x.size() * factor, 0.0);
+        for (size_t i = 0; i < x.size(); ++i)
+        {
+            u[i * factor] = x[i];
+        }
+        return u;
+    }
+
+    /**
+     * A `length` sample boxcar convolved with itself `passes` times, scaled by `gain` per pass.
+     */
+    std::vector<double> boxcarPower(int length, int passes, double gain = 1.0)
+    {
+        std::vector<double> h{1.0};
+        for (int pass = 0; pass < passes; ++pass)
+        {
+            std::vector<double> next(h.size() + length - 1, 0.0);
+            for (size_t i = 0; i < h.size(); ++i)
+            {
+                for (int j = 0; j < length; ++j)
+                {
+                    next[i + j] += h[i] * gain;
+                }
+            }
+            h = next;
+        }
+        return h;
+    }
+
+    /**
+     * Runs a same-rate streaming filter over the input in uneven chunks.
+     */
+    template<typename Filter>
+    std::vector<double> streamed(Filter& filter)
+    {
+        std::vector<double> y(INPUT_LENGTH);
+        test::forEachChunk(INPUT_LENGTH, [&](int offset, int count) {
+            filter.process(input().data() + offset, y.data() + offset, count);
+        });
+        return y;
+    }
+
+    /**
+     * Runs a rate-changing streaming filter over the input in uneven chunks.
+     */
+    template<typename Filter, typename In, typename Out>
+    std::vector<Out> streamedDecimating(Filter& filter, const std::vector<In>& x)
+    {
+        std::vector<Out> y(filter.maxOutputCount(static_cast<int>(x.size())) + 16);
+        int written = 0;
+        test::forEachChunk(static_cast<int>(x.size()), [&](int offset, int count) {
+            written += filter.process(x.data() + offset, count, y.data() + written);
+        });
+        y.resize(written);
+        return y;
+    }
+
+    template<int M>
+    void testFirFilter()
+    {
+        const std::vector<double> h = test::randomSignal<double>(M, M);
+        const std::vector<double> full = test::referenceConvolution<INPUT_LENGTH, M>(std::span<const double>(input()), std::span<const double>(h));
+        signals::FirFilter<double> filter(h);
+        const std::vector<double> expected(full.begin(), full.begin() + INPUT_LENGTH);
+        test::checkClose(streamed(filter), expected, TOLERANCE, "FirFilter " + std::to_string(M) + " taps");
+
+        filter.reset();
+        test::checkClose(streamed(filter), expected, TOLERANCE, "FirFilter " + std::to_string(M) + " taps after reset");
+    }
+
+    void testPartitionedConvolver()
+    {
+        constexpr int M = 500;
+        const std::vector<double> h = test::randomSignal<double>(M, 2);
+        const std::vector<double> full = test::referenceConvolution<INPUT_LENGTH, M>(std::span<const double>(input()), std::span<const double>(h));
+        for (int blockSize : {64, 96, 512})
+        {
+            signals::PartitionedConvolver<double> convolver(h, blockSize);
+            test::checkClose(streamed(convolver), delayed(full, convolver.latency(), INPUT_LENGTH), TOLERANCE,
+                             "PartitionedConvolver block " + std::to_string(blockSize));
+        }
+    }
+
+    void testZeroLatencyConvolver()
+    {
+        constexpr int M = 2500;
+        const std::vector<double> h = test::randomSignal<double>(M, 3);
+        const std::vector<double> full = test::referenceConvolution<INPUT_LENGTH, M>(std::span<const double>(input()), std::span<const double>(h));
+        const std::vector<double> expected(full.begin(), full.begin() + INPUT_LENGTH);
+        for (auto [head, maxBlock] : {std::pair{16, 1024}, {32, 256}, {64, 64}})
+        {
+            signals::ZeroLatencyConvolver<double> convolver(h, head, maxBlock);
+            const std::string name = "ZeroLatencyConvolver head " + std::to_string(head) + " max block " + std::to_string(maxBlock);
+            test::checkClose(streamed(convolver), expected, TOLERANCE, name);
+            convolver.reset();
+            test::checkClose(streamed(convolver), expected, TOLERANCE, name + " after reset");
+        }
+    }
+
+    void testFirDecimator()
+    {
+        constexpr int M = 63;
+        const std::vector<double> h = test::randomSignal<double>(M, 4);
+        const std::vector<double> full = test::referenceConvolution<INPUT_LENGTH, M>(std::span<const double>(input()), std::span<const double>(h));
+        for (int factor : {1, 2, 5, 7})
+        {
+            signals::FirDecimator<double> decimator(h, factor);
+            const int count = (INPUT_LENGTH + factor - 1) / factor;
+            test::checkClose(streamedDecimating<signals::FirDecimator<double>, double, double>(decimator, input()),
+                             downsampled(full, factor, count), TOLERANCE, "FirDecimator factor " + std::to_string(factor));
+        }
+    }
+
+    void testHalfBandDecimator()
+    {
+        constexpr int M = 31;
+        const std::vector<double> h = signals::halfBandLowpass<double>(M, 8.0);
+        const std::vector<double> full = test::referenceConvolution<INPUT_LENGTH, M>(std::span<const double>(input()), std::span<const double>(h));
+        signals::HalfBandDecimator<double> decimator(h);
+        test::checkClose(streamedDecimating<signals::HalfBandDecimator<double>, double, double>(decimator, input()),
+                         downsampled(full, 2, INPUT_LENGTH / 2), TOLERANCE, "HalfBandDecimator");
+    }
+
+    template<int Factor>
+    void testFirInterpolator()
+    {
+        constexpr int M = 48;
+        const std::vector<double> h = test::randomSignal<double>(M, 5);
+        const std::vector<double> u = zeroStuffed(input(), Factor);
+        const std::vector<double> full = test::referenceConvolution<INPUT_LENGTH * Factor, M>(std::span<const double>(u), std::span<const double>(h));
+
+        signals::FirInterpolator<double> interpolator(h, Factor);
+        std::vector<double> y(static_cast<size_t>(INPUT_LENGTH) * Factor);
+        test::forEachChunk(INPUT_LENGTH, [&](int offset, int count) {
+            interpolator.process(input().data() + offset, count, y.data() + static_cast<size_t>(offset) * Factor);
+        });
+        test::checkClose(y, std::vector<double>(full.begin(), full.begin() + y.size()), TOLERANCE,
+                         "FirInterpolator factor " + std::to_string(Factor));
+    }
+
+    /**
+     * A rational Resampler from Down to Up samples per unit time. Output n is
+     * \sum_i x[i] h(n Down / Up - i), which is zero-stuffing x by Up, convolving with h sampled
+     * every 1 / Up input samples, and keeping every Down-th output.
+     */
+    template<int Up, int Down>
+    void testResampler()
+    {
+        constexpr int N = 1000;
+        constexpr int KERNEL_CAPACITY = 256;
+        const std::vector<double> x(input().begin(), input().begin() + N);
+        const signals::ResamplerSettings settings;
+        signals::Resampler<double> resampler(Down, Up, settings);
+        const std::string name = "Resampler " + std::to_string(Down) + " -> " + std::to_string(Up);
+        test::check(resampler.isRational() && resampler.up() == Up && resampler.down() == Down, name + " is rational");
+
+        // The resampler's kernel, as documented: 2fc sinc(2fc t) kaiser(t / halfWidth)
+        const double fc = 0.5 * settings.cutoff * std::min(1.0, static_cast<double>(Up) / Down);
+        const double halfWidth = settings.zeroCrossings / (2.0 * fc);
+        const int centre = Up * resampler.taps() / 2;
+        test::check(2 * centre + 1 <= KERNEL_CAPACITY, name + " kernel fits");
+        std::vector<double> g(KERNEL_CAPACITY, 0.0);
+        for (int j = 0; j <= 2 * centre && j < KERNEL_CAPACITY; ++j)
+        {
+            const double t = static_cast<double>(j - centre) / Up;
+            g[j] = 2.0 * fc * signals::sinc(2.0 * fc * t) * signals::kaiserWindow(t / halfWidth, settings.kaiserBeta);
+        }
+        const std::vector<double> u = zeroStuffed(x, Up);
+        const std::vector<double> full = test::referenceConvolution<N * Up, KERNEL_CAPACITY>(std::span<const double>(u), std::span<const double>(g));
+
+        const std::vector<double> y = streamedDecimating<signals::Resampler<double>, double, double>(resampler, x);
+        test::check(static_cast<int>(y.size()) >= N * Up / Down - resampler.taps(), name + " output count");
+        std::vector<double> expected(y.size());
+        for (size_t n = 0; n < y.size(); ++n)
+        {
+            expected[n] = full[n * Down + centre];
+        }
+        test::checkClose(y, expected, TOLERANCE, name);
+    }
+
+    void testMovingAverages()
+    {
+        constexpr int M = 50;
+        const std::vector<double> ones(M, 1.0);
+        const std::vector<double> sum = test::referenceConvolution<INPUT_LENGTH, M>(std::span<const double>(input()), std::span<const double>(ones));
+
+        signals::MovingSum<double> movingSum(M);
+        test::checkClose(streamed(movingSum), std::vector<double>(sum.begin(), sum.begin() + INPUT_LENGTH), TOLERANCE, "MovingSum");
+
+        std::vector<double> average(sum.begin(), sum.begin() + INPUT_LENGTH);
+        for (double& v : average)
+        {
+            v /= M;
+        }
+        signals::MovingAverage<double> movingAverage(M);
+        test::checkClose(streamed(movingAverage), average, TOLERANCE, "MovingAverage");
+
+        constexpr int LENGTH = 20;
+        constexpr int PASSES = 3;
+        const std::vector<double> h = boxcarPower(LENGTH, PASSES, 1.0 / LENGTH);
+        const std::vector<double> full = test::referenceConvolution<INPUT_LENGTH, PASSES * (LENGTH - 1) + 1>(std::span<const double>(input()), std::span<const double>(h));
+        signals::CascadedMovingAverage<double> cascade(LENGTH, PASSES);
+        test::checkClose(streamed(cascade), std::vector<double>(full.begin(), full.begin() + INPUT_LENGTH), TOLERANCE, "CascadedMovingAverage");
+    }
+
+    /**
+     * CIC filters are checked exactly: with 16-bit inputs every sum is an integer well inside
+     * double precision.
+     */
+    void testCic()
+    {
+        std::vector<std::int16_t> x(INPUT_LENGTH);
+        std::vector<double> xd(INPUT_LENGTH);
+        for (int i = 0; i < INPUT_LENGTH; ++i)
+        {
+            x[i] = static_cast<std::int16_t>(std::lround(input()[i] * 32767.0));
+            xd[i] = x[i];
+        }
+
+        {
+            constexpr int FACTOR = 8, ORDER = 3, DELAY = 2;
+            constexpr int M = ORDER * (FACTOR * DELAY - 1) + 1;
+            const std::vector<double> h = boxcarPower(FACTOR * DELAY, ORDER);
+            const std::vector<double> full = test::referenceConvolution<INPUT_LENGTH, M>(std::span<const double>(xd), std::span<const double>(h));
+            const std::vector<double> expected = downsampled(full, FACTOR, INPUT_LENGTH / FACTOR);
+
+            signals::CicDecimator<std::int16_t> decimator(FACTOR, ORDER, DELAY);
+            const std::vector<std::int64_t> y = streamedDecimating<signals::CicDecimator<std::int16_t>, std::int16_t, std::int64_t>(decimator, x);
+            test::checkClose(std::vector<double>(y.begin(), y.end()), expected, 0.0, "CicDecimator");
+
+            decimator.reset();
+            std::vector<double> scaled = expected;
+            for (double& v : scaled)
+            {
+                v /= decimator.gain();
+            }
+            test::checkClose(streamedDecimating<signals::CicDecimator<std::int16_t>, std::int16_t, double>(decimator, x), scaled,
+                             TOLERANCE, "CicDecimator unity gain");
+        }
+
+        {
+            constexpr int FACTOR = 5, ORDER = 4;
+            constexpr int M = ORDER * (FACTOR - 1) + 1;
+            const std::vector<double> h = boxcarPower(FACTOR, ORDER);
+            const std::vector<double> u = zeroStuffed(xd, FACTOR);
+            const std::vector<double> full = test::referenceConvolution<INPUT_LENGTH * FACTOR, M>(std::span<const double>(u), std::span<const double>(h));
+
+            signals::CicInterpolator<std::int16_t> interpolator(FACTOR, ORDER);
+            std::vector<std::int64_t> y(static_cast<size_t>(INPUT_LENGTH) * FACTOR);
+            test::forEachChunk(INPUT_LENGTH, [&](int offset, int count) {
+                interpolator.process(x.data() + offset, count, y.data() + static_cast<size_t>(offset) * FACTOR);
+            });
+            test::checkClose(std::vector<double>(y.begin(), y.end()), std::vector<double>(full.begin(), full.begin() + y.size()), 0.0,
+                             "CicInterpolator");
+        }
+
+        // The integrators wrap many times over on full-scale DC, and the output must still be exact
+        signals::CicDecimator<std::int32_t> wide(4096, 4, 1, 16);
+        const std::vector<std::int32_t> dc(1 << 16, std::numeric_limits<std::int16_t>::max());
+        const std::vector<double> y = streamedDecimating<signals::CicDecimator<std::int32_t>, std::int32_t, double>(wide, dc);
+        test::check(!y.empty() && y.back() == std::numeric_limits<std::int16_t>::max(), "CicDecimator wraps safely at 64 bits of gain");
+
+        // With M = 3 the CIC has a null at 1/3 of the low rate, which a passband can't reach past
+        const std::vector<double> below = signals::cicCompensationFilter<double>(4, 16, 3, 31, 0.3);
+        test::check(below.size() == 31 && std::isfinite(below[15]), "cicCompensationFilter accepts a passband below the first null");
+        for (double passband : {1.0 / 3.0, 0.4})
+        {
+            bool rejected = false;
+            try
+            {
+                signals::cicCompensationFilter<double>(4, 16, 3, 31, passband);
+            }
+            catch (const std::invalid_argument&)
+            {
+                rejected = true;
+            }
+            test::check(rejected, "cicCompensationFilter rejects passband " + std::to_string(passband) + " with differential delay 3");
+        }
+    }
+}
+
+int main()
+{
+    testFirFilter<1>();
+    testFirFilter<37>();
+    testFirFilter<300>();
+    testPartitionedConvolver();
+    testZeroLatencyConvolver();
+    testFirDecimator();
+    testHalfBandDecimator();
+    testFirInterpolator<1>();
+    testFirInterpolator<4>();
+    testResampler<2, 3>();
+    testResampler<3, 2>();
+    testMovingAverages();
+    testCic();
+    return dsp::test::finish("test_streaming");
+}